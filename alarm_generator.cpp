@@ -0,0 +1,322 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+// 与 alarm_list.txt 相同规模的默认参数
+const int DEFAULT_ENGINEERS = 336;
+const int DEFAULT_SERVERS = 1620;
+const int DEFAULT_DAYS = 22;
+const int FIRST_14_DAYS = 14;
+
+enum FiringPattern : uint8_t {
+    PATTERN_BURSTY = 0,    // 两状态马尔可夫链：安静期/爆发期
+    PATTERN_PERIODIC = 1,  // 固定周期 + 相位，带少量噪声
+    PATTERN_HEAVY_TAIL = 2 // 每台服务器的触发率服从 Pareto 分布
+};
+
+struct GeneratorConfig {
+    int engineers = DEFAULT_ENGINEERS;
+    long long servers = DEFAULT_SERVERS;
+    int days = DEFAULT_DAYS;
+    uint64_t seed = 1;
+    string output = "generated_alarm_list.txt";
+
+    // 三种触发分布的混合权重（会自动归一化）
+    double bursty_weight = 0.3;
+    double periodic_weight = 0.3;
+    double heavy_tail_weight = 0.4;
+
+    // 在前14天内至少触发一次的服务器比例
+    double first_14_share = 0.9;
+
+    // 相关服务器组：同组服务器以 correlation 的概率共享同一个随机数
+    int groups = 0;
+    double correlation = 0.5;
+
+    // bursty 参数
+    double burst_enter = 0.10;
+    double burst_exit = 0.30;
+    double burst_rate = 0.80;
+    double quiet_rate = 0.02;
+
+    // periodic 参数
+    int min_period = 2;
+    int max_period = 7;
+    double periodic_hit = 0.90;
+    double periodic_noise = 0.02;
+
+    // heavy-tail 参数
+    double tail_alpha = 1.5;
+    double tail_scale = 0.08;
+};
+
+class AlarmListGenerator {
+private:
+    GeneratorConfig config;
+    mt19937_64 rng;
+    uniform_real_distribution<double> uniform{0.0, 1.0};
+
+    // 按服务器存储的状态（结构数组，10^7 台服务器约 100MB）
+    vector<uint8_t> pattern;
+    vector<float> rate;           // heavy-tail 触发率 / bursty 当前状态下不用
+    vector<uint8_t> period;
+    vector<uint8_t> phase;
+    vector<uint8_t> in_burst;
+    vector<uint8_t> covers_first_14;
+    vector<uint8_t> fired_first_14;
+    vector<uint8_t> first_14_deadline; // 到这一天还没触发过就强制触发，均匀分布在前14天内
+
+public:
+    explicit AlarmListGenerator(const GeneratorConfig& cfg) : config(cfg), rng(cfg.seed) {}
+
+    bool generate() {
+        auto start = chrono::steady_clock::now();
+        initializeServers();
+
+        // 每天至少要有一台服务器触发，前14天只有覆盖前14天的服务器可以触发
+        long long covering = 0;
+        for (long long s = 0; s < config.servers; s++) covering += covers_first_14[s];
+        if (covering == 0) {
+            cerr << "Error: --first14-share " << config.first_14_share
+                 << " leaves no server that may fire in the first " << FIRST_14_DAYS << " days" << endl;
+            return false;
+        }
+
+        ofstream file(config.output, ios::binary);
+        if (!file.is_open()) {
+            cerr << "Error: Cannot create " << config.output << endl;
+            return false;
+        }
+
+        file << "# " << config.days << "天警报列表 - 每行代表一天的警报服务器编号\n";
+        file << "# 生成参数: engineers=" << config.engineers
+             << " servers=" << config.servers
+             << " days=" << config.days
+             << " seed=" << config.seed
+             << " first14_share=" << config.first_14_share
+             << " groups=" << config.groups
+             << " correlation=" << config.correlation
+             << " mix=" << config.bursty_weight << "/" << config.periodic_weight << "/" << config.heavy_tail_weight
+             << "\n";
+
+        vector<double> group_draw(max(config.groups, 1));
+        string line;
+        line.reserve(1 << 20);
+        long long total_alarms = 0;
+
+        for (int day = 0; day < config.days; day++) {
+            for (double& u : group_draw) u = uniform(rng);
+
+            line.clear();
+            long long count = 0;
+
+            for (long long s = 0; s < config.servers; s++) {
+                bool fires = drawFiring(s, day, group_draw);
+
+                if (day < FIRST_14_DAYS) {
+                    if (!covers_first_14[s]) {
+                        fires = false;
+                    } else if (day == first_14_deadline[s] && !fired_first_14[s] && !fires) {
+                        // 保证覆盖前14天的服务器在前14天内至少触发一次；期限分散在各天，
+                        // 不会把所有补触发都堆到第13天
+                        fires = true;
+                    }
+                    if (fires) fired_first_14[s] = 1;
+                }
+
+                if (fires) {
+                    appendServer(line, s);
+                    count++;
+                }
+            }
+
+            // 各求解器都会跳过空行，空的一天会让后续天数错位，所以至少保留一台服务器。
+            // 前14天只能从覆盖前14天的服务器里挑，上面已经确认至少有一台
+            if (count == 0) {
+                long long s = (long long)(rng() % config.servers);
+                while (day < FIRST_14_DAYS && !covers_first_14[s]) s = (s + 1) % config.servers;
+                if (day < FIRST_14_DAYS) fired_first_14[s] = 1;
+                appendServer(line, s);
+                count = 1;
+            }
+
+            line.back() = '\n';
+            file << "# 第" << day << "天: " << count << "台服务器\n";
+            file.write(line.data(), line.size());
+            total_alarms += count;
+        }
+
+        file.close();
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Generated " << config.days << " days, " << config.servers << " servers, "
+             << total_alarms << " alarms in " << seconds << "s" << endl;
+        cout << "Alarm list saved to " << config.output << endl;
+        return true;
+    }
+
+private:
+    void initializeServers() {
+        long long n = config.servers;
+        pattern.assign(n, PATTERN_HEAVY_TAIL);
+        rate.assign(n, 0.0f);
+        period.assign(n, 1);
+        phase.assign(n, 0);
+        in_burst.assign(n, 0);
+        covers_first_14.assign(n, 0);
+        fired_first_14.assign(n, 0);
+        first_14_deadline.assign(n, 0);
+        int first_14_days = min(FIRST_14_DAYS, config.days);
+
+        double total_weight = config.bursty_weight + config.periodic_weight + config.heavy_tail_weight;
+        double bursty_cut = config.bursty_weight / total_weight;
+        double periodic_cut = bursty_cut + config.periodic_weight / total_weight;
+
+        for (long long s = 0; s < n; s++) {
+            double u = uniform(rng);
+            if (u < bursty_cut) {
+                pattern[s] = PATTERN_BURSTY;
+                in_burst[s] = uniform(rng) < config.burst_enter / (config.burst_enter + config.burst_exit);
+            } else if (u < periodic_cut) {
+                pattern[s] = PATTERN_PERIODIC;
+                int span = config.max_period - config.min_period + 1;
+                period[s] = config.min_period + (int)(rng() % span);
+                phase[s] = rng() % period[s];
+            } else {
+                pattern[s] = PATTERN_HEAVY_TAIL;
+                // Pareto(alpha) 采样：scale * U^(-1/alpha)，截断到 1
+                double pareto = config.tail_scale * pow(1.0 - uniform(rng), -1.0 / config.tail_alpha);
+                rate[s] = (float)min(1.0, pareto);
+            }
+
+            covers_first_14[s] = uniform(rng) < config.first_14_share;
+            first_14_deadline[s] = rng() % first_14_days;
+        }
+    }
+
+    bool drawFiring(long long s, int day, const vector<double>& group_draw) {
+        double p;
+        switch (pattern[s]) {
+            case PATTERN_BURSTY:
+                if (day > 0) {
+                    double flip = uniform(rng);
+                    if (in_burst[s]) {
+                        if (flip < config.burst_exit) in_burst[s] = 0;
+                    } else {
+                        if (flip < config.burst_enter) in_burst[s] = 1;
+                    }
+                }
+                p = in_burst[s] ? config.burst_rate : config.quiet_rate;
+                break;
+            case PATTERN_PERIODIC:
+                p = ((day + phase[s]) % period[s] == 0) ? config.periodic_hit : config.periodic_noise;
+                break;
+            default:
+                p = rate[s];
+                break;
+        }
+
+        double u;
+        if (config.groups > 0 && uniform(rng) < config.correlation) {
+            long long group = s * config.groups / config.servers;
+            u = group_draw[group];
+        } else {
+            u = uniform(rng);
+        }
+        return u < p;
+    }
+
+    static void appendServer(string& line, long long server) {
+        char buffer[24];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), server);
+        line.append(buffer, result.ptr);
+        line.push_back(' ');
+    }
+};
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << "  --engineers N        工程师数量 (默认 " << DEFAULT_ENGINEERS << ")" << endl;
+    cout << "  --servers N          服务器数量 (默认 " << DEFAULT_SERVERS << ")" << endl;
+    cout << "  --days N             天数 (默认 " << DEFAULT_DAYS << ")" << endl;
+    cout << "  --seed N             随机种子 (默认 1)" << endl;
+    cout << "  --out FILE           输出文件 (默认 generated_alarm_list.txt)" << endl;
+    cout << "  --mix B/P/H          bursty/periodic/heavy-tail 权重 (默认 0.3/0.3/0.4)" << endl;
+    cout << "  --first14-share F    前14天至少触发一次的服务器比例 (默认 0.9)" << endl;
+    cout << "  --groups N           相关服务器组数量，0 表示不相关 (默认 0)" << endl;
+    cout << "  --correlation R      组内共享随机数的概率 (默认 0.5)" << endl;
+    cout << "  --tail-alpha A       heavy-tail Pareto 指数 (默认 1.5)" << endl;
+    cout << "  --tail-scale S       heavy-tail 最小触发率 (默认 0.08)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--engineers") config.engineers = stoi(value);
+        else if (arg == "--servers") config.servers = stoll(value);
+        else if (arg == "--days") config.days = stoi(value);
+        else if (arg == "--seed") config.seed = stoull(value);
+        else if (arg == "--out") config.output = value;
+        else if (arg == "--first14-share") config.first_14_share = stod(value);
+        else if (arg == "--groups") config.groups = stoi(value);
+        else if (arg == "--correlation") config.correlation = stod(value);
+        else if (arg == "--tail-alpha") config.tail_alpha = stod(value);
+        else if (arg == "--tail-scale") config.tail_scale = stod(value);
+        else if (arg == "--mix") {
+            char sep1, sep2;
+            istringstream iss(value);
+            if (!(iss >> config.bursty_weight >> sep1 >> config.periodic_weight >> sep2 >> config.heavy_tail_weight)) {
+                cerr << "Error: --mix expects B/P/H, got " << value << endl;
+                return 1;
+            }
+        } else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.servers <= 0 || config.days <= 0 || config.engineers <= 0) {
+        cerr << "Error: engineers, servers and days must be positive" << endl;
+        return 1;
+    }
+    if (config.bursty_weight + config.periodic_weight + config.heavy_tail_weight <= 0) {
+        cerr << "Error: --mix weights must not all be zero" << endl;
+        return 1;
+    }
+    if (config.groups < 0 || config.groups > config.servers) {
+        cerr << "Error: --groups must be between 0 and the number of servers" << endl;
+        return 1;
+    }
+
+    cout << "=== Alarm List Generator ===" << endl;
+    cout << "Engineers: " << config.engineers << endl;
+    cout << "Servers: " << config.servers << endl;
+    cout << "Days: " << config.days << endl;
+    cout << "Seed: " << config.seed << endl;
+
+    AlarmListGenerator generator(config);
+    return generator.generate() ? 0 : 1;
+}
@@ -0,0 +1,582 @@
+#ifndef ALARM_INDEX_H
+#define ALARM_INDEX_H
+
+// 警报数据的预处理索引（天掩码、掩码类、前14天标记、候选排序），
+// 可以序列化为带版本号的二进制快照，之后的运行直接 mmap 使用。
+//
+// 快照默认保存在警报文件旁边（alarm_list.txt.idx），文件头记录了警报文件的
+// 内容哈希、大小和修改时间：大小和修改时间一致时直接使用快照，否则重新计算
+// 内容哈希，哈希不一致才重新解析文本并重写快照。
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "perf_counters.h"
+
+const uint32_t ALARM_INDEX_MAGIC = 0x58444941;  // "AIDX"
+const uint32_t ALARM_INDEX_VERSION = 1;
+const int ALARM_INDEX_MASK_DAYS = 64;           // 每台服务器一个 64 位天掩码，只覆盖前 64 天
+const int ALARM_INDEX_MAX_DAYS = 512;           // 按天的服务器列表最多支持的天数（更长的周期用 day_mask.h）
+const int ALARM_INDEX_FIRST_14_DAYS = 14;
+const uint32_t ALARM_INDEX_MAX_SERVERS = 1u << 26; // 服务器编号上限：每台服务器的数组按编号分配，一个离谱的编号不能撑爆内存
+
+struct AlarmIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t content_hash;
+    uint64_t file_size;
+    int64_t file_mtime_ns;
+
+    uint32_t num_days;
+    uint32_t num_servers;         // 最大服务器编号 + 1（或生成器声明的服务器数量）
+    uint32_t declared_engineers;  // 生成器头部声明的工程师数量，没有则为 0
+    uint32_t num_classes;
+    uint64_t num_alarms;
+    uint32_t num_candidates;
+    uint32_t reserved;
+
+    // 各数组在快照中的字节偏移（均按 8 字节对齐）
+    uint64_t day_mask_offset;        // uint64_t[num_servers]
+    uint64_t first14_offset;         // uint8_t[num_servers]
+    uint64_t class_of_offset;        // uint32_t[num_servers]
+    uint64_t class_mask_offset;      // uint64_t[num_classes]
+    uint64_t class_start_offset;     // uint32_t[num_classes + 1]
+    uint64_t class_servers_offset;   // int32_t[num_servers]
+    uint64_t candidate_order_offset; // int32_t[num_candidates]
+    uint64_t day_start_offset;       // uint64_t[num_days + 1]
+    uint64_t day_servers_offset;     // int32_t[num_alarms]
+    uint64_t total_size;
+};
+
+// 64 位内容哈希：按 8 字节分块的乘法混合，最后做 fmix64 雪崩
+inline uint64_t hashAlarmBytes(const char* data, size_t size) {
+    const uint64_t k1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t k2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t h = 0x27D4EB2F165667C5ULL ^ (size * k1);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        h ^= word * k2;
+        h = (h << 31) | (h >> 33);
+        h *= k1;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, data + i, size - i);
+    h ^= tail * k2;
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// 只读映射整个文件，析构时自动解除映射
+class MappedFile {
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = st.st_size;
+        if (size_ > 0) {
+            data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED) {
+                data_ = nullptr;
+                size_ = 0;
+                ::close(fd);
+                return false;
+            }
+        }
+        ::close(fd);
+        return true;
+    }
+
+    void close() {
+        if (data_) munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data() const { return static_cast<const char*>(data_); }
+    size_t size() const { return size_; }
+};
+
+class AlarmIndex {
+private:
+    // 索引数据要么在 storage 中（刚从文本构建），要么在 snapshot 映射中
+    std::vector<uint64_t> storage;
+    MappedFile snapshot;
+    const char* base = nullptr;
+    const AlarmIndexHeader* header = nullptr;
+
+    const uint64_t* day_mask_ = nullptr;
+    const uint8_t* first14_ = nullptr;
+    const uint32_t* class_of_ = nullptr;
+    const uint64_t* class_mask_ = nullptr;
+    const uint32_t* class_start_ = nullptr;
+    const int32_t* class_servers_ = nullptr;
+    const int32_t* candidate_order_ = nullptr;
+    const uint64_t* day_start_ = nullptr;
+    const int32_t* day_servers_ = nullptr;
+
+    bool from_snapshot = false;
+    double load_ms = 0.0;
+
+public:
+    AlarmIndex() = default;
+    AlarmIndex(const AlarmIndex&) = delete;
+    AlarmIndex& operator=(const AlarmIndex&) = delete;
+    AlarmIndex(AlarmIndex&& other) noexcept { *this = std::move(other); }
+    AlarmIndex& operator=(AlarmIndex&& other) noexcept {
+        if (this != &other) {
+            storage = std::move(other.storage);
+            snapshot = std::move(other.snapshot);
+            base = nullptr;
+            from_snapshot = other.from_snapshot;
+            load_ms = other.load_ms;
+            bindArrays();
+            other.base = nullptr;
+            other.header = nullptr;
+        }
+        return *this;
+    }
+
+    // 加载警报文件的索引：优先使用有效的快照，否则解析文本并写出新快照。
+    // 设置环境变量 ALARM_INDEX_SNAPSHOT=0 可以禁用快照；verbose=false 时不输出加载信息。
+    bool load(const std::string& alarm_file, bool verbose = true) {
+        auto start = std::chrono::steady_clock::now();
+
+        const char* env = getenv("ALARM_INDEX_SNAPSHOT");
+        bool use_snapshot = !(env && std::string(env) == "0");
+        std::string snapshot_file = snapshotPath(alarm_file);
+
+        struct stat st;
+        if (stat(alarm_file.c_str(), &st) != 0) {
+            std::cerr << "Error: Cannot open " << alarm_file << std::endl;
+            return false;
+        }
+
+        if (use_snapshot && mapSnapshot(snapshot_file)) {
+            bool valid = header->file_size == (uint64_t)st.st_size && header->file_mtime_ns == mtimeNs(st);
+            if (!valid) {
+                MappedFile text;
+                valid = text.open(alarm_file) && hashAlarmBytes(text.data(), text.size()) == header->content_hash;
+            }
+            if (valid) {
+                from_snapshot = true;
+                load_ms = elapsedMs(start);
+                if (verbose) std::cout << "Loaded alarm index snapshot " << snapshot_file << " (" << numDays() << " days, "
+                          << numServers() << " servers, " << load_ms << " ms)" << std::endl;
+                return true;
+            }
+            if (verbose) std::cout << "Alarm index snapshot is stale, rebuilding" << std::endl;
+        }
+
+        if (!buildFromText(alarm_file)) return false;
+        load_ms = elapsedMs(start);
+        if (verbose) std::cout << "Built alarm index from " << alarm_file << " (" << numDays() << " days, "
+                  << numServers() << " servers, " << numAlarms() << " alarms, " << load_ms << " ms)" << std::endl;
+
+        if (use_snapshot && !saveSnapshot(snapshot_file)) {
+            std::cerr << "Warning: Cannot write alarm index snapshot " << snapshot_file << std::endl;
+        }
+        return true;
+    }
+
+    static std::string snapshotPath(const std::string& alarm_file) { return alarm_file + ".idx"; }
+
+    // 解析文本格式：跳过空行和不以数字开头的行（注释），每个数据行是一天
+    bool buildFromText(const std::string& alarm_file) {
+        MappedFile text;
+        if (!text.open(alarm_file)) {
+            std::cerr << "Error: Cannot open " << alarm_file << std::endl;
+            return false;
+        }
+
+        struct stat st;
+        stat(alarm_file.c_str(), &st);
+
+        std::vector<uint64_t> day_start(1, 0);
+        std::vector<int32_t> day_servers;
+        int32_t max_server = -1;
+        uint32_t declared_servers = 0;
+        uint32_t declared_engineers = 0;
+
+        PerfScope parse_scope(PERF_PARSE);
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end) {
+            const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (!line_end) line_end = end;
+
+            if (p < line_end && *p >= '0' && *p <= '9') {
+                const char* q = p;
+                while (q < line_end) {
+                    while (q < line_end && !(*q >= '0' && *q <= '9') && *q != '-') q++;
+                    if (q >= line_end) break;
+                    bool negative = (*q == '-');
+                    if (negative) q++;
+                    int64_t value = 0;
+                    while (q < line_end && *q >= '0' && *q <= '9') {
+                        if (value < ALARM_INDEX_MAX_SERVERS) value = value * 10 + (*q - '0');
+                        q++;
+                    }
+                    if (negative) continue;
+                    if (value >= ALARM_INDEX_MAX_SERVERS) {
+                        std::cerr << "Error: " << alarm_file << " has a server id >= " << ALARM_INDEX_MAX_SERVERS
+                                  << ", the index supports ids below that" << std::endl;
+                        return false;
+                    }
+                    day_servers.push_back((int32_t)value);
+                    max_server = std::max(max_server, (int32_t)value);
+                }
+                day_start.push_back(day_servers.size());
+            } else if (p < line_end && *p == '#') {
+                // 生成器写入的维度声明: "# 生成参数: engineers=336 servers=1620 ..."
+                std::string comment(p, line_end);
+                declared_engineers = std::max(declared_engineers, parseDeclared(comment, "engineers="));
+                declared_servers = std::max(declared_servers, parseDeclared(comment, "servers="));
+                if (declared_servers > ALARM_INDEX_MAX_SERVERS) {
+                    std::cerr << "Error: " << alarm_file << " declares " << declared_servers
+                              << " servers, the index supports at most " << ALARM_INDEX_MAX_SERVERS << std::endl;
+                    return false;
+                }
+            }
+            p = line_end + 1;
+        }
+        parse_scope.stop();
+
+        PerfScope build_scope(PERF_INDEX_BUILD);
+        int num_days = day_start.size() - 1;
+        if (num_days > ALARM_INDEX_MAX_DAYS) {
+            std::cerr << "Error: " << alarm_file << " has " << num_days << " days, the index supports at most "
+                      << ALARM_INDEX_MAX_DAYS << std::endl;
+            return false;
+        }
+
+        uint32_t num_servers = std::max<uint32_t>(declared_servers, max_server + 1);
+        std::vector<uint64_t> day_mask(num_servers, 0);
+        for (int day = 0; day < std::min(num_days, ALARM_INDEX_MASK_DAYS); day++) {
+            for (uint64_t i = day_start[day]; i < day_start[day + 1]; i++) {
+                day_mask[day_servers[i]] |= 1ULL << day;
+            }
+        }
+
+        uint64_t first14_mask = (1ULL << std::min(num_days, ALARM_INDEX_FIRST_14_DAYS)) - 1;
+
+        // 掩码类：天掩码完全相同的服务器归为一类，类按掩码升序编号
+        std::vector<std::pair<uint64_t, int32_t>> by_mask(num_servers);
+        for (uint32_t s = 0; s < num_servers; s++) by_mask[s] = {day_mask[s], (int32_t)s};
+        std::sort(by_mask.begin(), by_mask.end());
+
+        std::vector<int32_t> class_servers(num_servers);
+        std::vector<uint32_t> class_of(num_servers);
+        std::vector<uint64_t> class_mask;
+        std::vector<uint32_t> class_start;
+        for (uint32_t i = 0; i < num_servers; i++) {
+            auto [m, s] = by_mask[i];
+            if (i == 0 || m != by_mask[i - 1].first) {
+                class_mask.push_back(m);
+                class_start.push_back(i);
+            }
+            class_servers[i] = s;
+            class_of[s] = class_mask.size() - 1;
+        }
+        class_start.push_back(num_servers);
+        by_mask.clear();
+        by_mask.shrink_to_fit();
+
+        // 候选排序：前14天覆盖天数降序，总覆盖天数降序，编号升序；不含从不报警的服务器。
+        // 排序键打包成一个 64 位整数，避免在比较函数里重复计算 popcount
+        std::vector<uint64_t> candidate_keys;
+        for (uint32_t s = 0; s < num_servers; s++) {
+            if (!day_mask[s]) continue;
+            uint64_t first_14 = __builtin_popcountll(day_mask[s] & first14_mask);
+            uint64_t coverage = __builtin_popcountll(day_mask[s]);
+            candidate_keys.push_back(((64 - first_14) << 40) | ((64 - coverage) << 32) | s);
+        }
+        std::sort(candidate_keys.begin(), candidate_keys.end());
+        std::vector<int32_t> candidate_order(candidate_keys.size());
+        for (size_t i = 0; i < candidate_keys.size(); i++) candidate_order[i] = (int32_t)(candidate_keys[i] & 0xFFFFFFFFULL);
+        candidate_keys.clear();
+        candidate_keys.shrink_to_fit();
+
+        // 按快照布局排列到一块连续内存中，写快照时直接整体写出
+        AlarmIndexHeader h;
+        memset(&h, 0, sizeof(h));
+        h.magic = ALARM_INDEX_MAGIC;
+        h.version = ALARM_INDEX_VERSION;
+        h.content_hash = hashAlarmBytes(text.data(), text.size());
+        h.file_size = text.size();
+        h.file_mtime_ns = mtimeNs(st);
+        h.num_days = num_days;
+        h.num_servers = num_servers;
+        h.declared_engineers = declared_engineers;
+        h.num_classes = class_mask.size();
+        h.num_alarms = day_servers.size();
+        h.num_candidates = candidate_order.size();
+
+        uint64_t offset = align8(sizeof(AlarmIndexHeader));
+        auto place = [&](uint64_t& field, uint64_t bytes) {
+            field = offset;
+            offset = align8(offset + bytes);
+        };
+        place(h.day_mask_offset, num_servers * sizeof(uint64_t));
+        place(h.first14_offset, num_servers * sizeof(uint8_t));
+        place(h.class_of_offset, num_servers * sizeof(uint32_t));
+        place(h.class_mask_offset, class_mask.size() * sizeof(uint64_t));
+        place(h.class_start_offset, class_start.size() * sizeof(uint32_t));
+        place(h.class_servers_offset, num_servers * sizeof(int32_t));
+        place(h.candidate_order_offset, candidate_order.size() * sizeof(int32_t));
+        place(h.day_start_offset, day_start.size() * sizeof(uint64_t));
+        place(h.day_servers_offset, day_servers.size() * sizeof(int32_t));
+        h.total_size = offset;
+
+        storage.assign(h.total_size / 8, 0);
+        snapshot.close();
+        char* out = reinterpret_cast<char*>(storage.data());
+        memcpy(out, &h, sizeof(h));
+        memcpy(out + h.day_mask_offset, day_mask.data(), num_servers * sizeof(uint64_t));
+        uint8_t* first14 = reinterpret_cast<uint8_t*>(out + h.first14_offset);
+        for (uint32_t s = 0; s < num_servers; s++) first14[s] = (day_mask[s] & first14_mask) != 0;
+        memcpy(out + h.class_of_offset, class_of.data(), num_servers * sizeof(uint32_t));
+        memcpy(out + h.class_mask_offset, class_mask.data(), class_mask.size() * sizeof(uint64_t));
+        memcpy(out + h.class_start_offset, class_start.data(), class_start.size() * sizeof(uint32_t));
+        memcpy(out + h.class_servers_offset, class_servers.data(), num_servers * sizeof(int32_t));
+        memcpy(out + h.candidate_order_offset, candidate_order.data(), candidate_order.size() * sizeof(int32_t));
+        memcpy(out + h.day_start_offset, day_start.data(), day_start.size() * sizeof(uint64_t));
+        memcpy(out + h.day_servers_offset, day_servers.data(), day_servers.size() * sizeof(int32_t));
+
+        base = out;
+        from_snapshot = false;
+        bindArrays();
+        return true;
+    }
+
+    bool saveSnapshot(const std::string& path) const {
+        if (!header) return false;
+        // 每个进程用自己的临时文件，同时重建同一个索引的进程不会写到一起；rename 是原子的
+        std::string tmp = path + ".tmp." + std::to_string(getpid());
+        std::ofstream file(tmp, std::ios::binary);
+        if (!file.is_open()) return false;
+        file.write(base, header->total_size);
+        file.close();
+        if (!file) {
+            remove(tmp.c_str());
+            return false;
+        }
+        return rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    bool mapSnapshot(const std::string& path) {
+        MappedFile mapped;
+        if (!mapped.open(path) || !validSnapshot(mapped.data(), mapped.size())) return false;
+
+        storage.clear();
+        snapshot = std::move(mapped);
+        base = snapshot.data();
+        bindArrays();
+        return true;
+    }
+
+    // 从内存中的快照字节装入（复制一份），例如分布式求解中协调进程发来的快照
+    bool loadSnapshotBytes(const char* data, size_t size) {
+        if (!validSnapshot(data, size)) return false;
+        storage.assign((size + 7) / 8, 0);
+        memcpy(storage.data(), data, size);
+        snapshot.close();
+        from_snapshot = true;
+        bindArrays();
+        return true;
+    }
+
+    // 快照的原始字节，可以原样交给另一个进程的 loadSnapshotBytes
+    const char* snapshotData() const { return base; }
+    size_t snapshotSize() const { return header ? header->total_size : 0; }
+
+    // ---- 维度 ----
+    int numDays() const { return header->num_days; }
+    int numServers() const { return header->num_servers; }
+    int declaredEngineers() const { return header->declared_engineers; }
+    int numClasses() const { return header->num_classes; }
+    uint64_t numAlarms() const { return header->num_alarms; }
+    uint64_t contentHash() const { return header->content_hash; }
+    bool loadedFromSnapshot() const { return from_snapshot; }
+    double loadMillis() const { return load_ms; }
+
+    uint64_t allDaysMask() const { return numDays() < ALARM_INDEX_MASK_DAYS ? (1ULL << numDays()) - 1 : ~0ULL; }
+    // 超过 64 天时天掩码只包含前 64 天，需要完整周期的代码改用 dayBegin/dayEnd 或 DayMask<W>
+    bool masksCoverAllDays() const { return numDays() <= ALARM_INDEX_MASK_DAYS; }
+    uint64_t first14Mask() const {
+        return numDays() >= ALARM_INDEX_FIRST_14_DAYS ? (1ULL << ALARM_INDEX_FIRST_14_DAYS) - 1 : allDaysMask();
+    }
+
+    // ---- 每台服务器 ----
+    uint64_t mask(int server) const { return day_mask_[server]; }
+    const uint64_t* masks() const { return day_mask_; }
+    bool coversFirst14(int server) const { return first14_[server] != 0; }
+    int coverage(int server) const { return __builtin_popcountll(day_mask_[server]); }
+
+    // ---- 掩码类 ----
+    uint32_t classOf(int server) const { return class_of_[server]; }
+    uint64_t classMask(uint32_t c) const { return class_mask_[c]; }
+    const int32_t* classBegin(uint32_t c) const { return class_servers_ + class_start_[c]; }
+    const int32_t* classEnd(uint32_t c) const { return class_servers_ + class_start_[c + 1]; }
+
+    // ---- 候选排序（前14天覆盖降序，总覆盖降序，编号升序）----
+    const int32_t* candidatesBegin() const { return candidate_order_; }
+    const int32_t* candidatesEnd() const { return candidate_order_ + header->num_candidates; }
+    int numCandidates() const { return header->num_candidates; }
+
+    // ---- 每天的报警服务器（保持文件中的顺序）----
+    const int32_t* dayBegin(int day) const { return day_servers_ + day_start_[day]; }
+    const int32_t* dayEnd(int day) const { return day_servers_ + day_start_[day + 1]; }
+    int daySize(int day) const { return day_start_[day + 1] - day_start_[day]; }
+
+private:
+    // 快照可能来自磁盘或网络：bindArrays 用到的每个数组都必须 8 字节对齐并完整落在快照内，
+    // 并且数组里的下标、区间边界都要落在对应维度内，访问器才不会越界
+    static bool validSnapshot(const char* data, size_t size) {
+        if (!data || size < sizeof(AlarmIndexHeader)) return false;
+        AlarmIndexHeader h;
+        memcpy(&h, data, sizeof(h));
+        if (h.magic != ALARM_INDEX_MAGIC || h.version != ALARM_INDEX_VERSION || h.total_size != size ||
+            h.num_days > ALARM_INDEX_MAX_DAYS) {
+            return false;
+        }
+
+        // 按除法比较，元素数量再大也不会溢出
+        auto fits = [&](uint64_t offset, uint64_t count, uint64_t element) {
+            return offset % 8 == 0 && offset >= sizeof(AlarmIndexHeader) && offset <= h.total_size &&
+                   count <= (h.total_size - offset) / element;
+        };
+        bool layout_ok = fits(h.day_mask_offset, h.num_servers, sizeof(uint64_t)) &&
+                         fits(h.first14_offset, h.num_servers, sizeof(uint8_t)) &&
+                         fits(h.class_of_offset, h.num_servers, sizeof(uint32_t)) &&
+                         fits(h.class_mask_offset, h.num_classes, sizeof(uint64_t)) &&
+                         fits(h.class_start_offset, (uint64_t)h.num_classes + 1, sizeof(uint32_t)) &&
+                         fits(h.class_servers_offset, h.num_servers, sizeof(int32_t)) &&
+                         fits(h.candidate_order_offset, h.num_candidates, sizeof(int32_t)) &&
+                         fits(h.day_start_offset, (uint64_t)h.num_days + 1, sizeof(uint64_t)) &&
+                         fits(h.day_servers_offset, h.num_alarms, sizeof(int32_t));
+        if (!layout_ok || h.num_candidates > h.num_servers) return false;
+
+        // 网络收到的字节不保证对齐，逐个 memcpy 读取
+        auto at = [&](uint64_t offset, uint64_t i, auto zero) {
+            decltype(zero) value;
+            memcpy(&value, data + offset + i * sizeof(value), sizeof(value));
+            return value;
+        };
+        // 区间边界数组：从 0 开始、单调不减、以 last 结束
+        auto validBounds = [&](uint64_t offset, uint64_t count, uint64_t last, auto zero) {
+            if ((uint64_t)at(offset, 0, zero) != 0) return false;
+            for (uint64_t i = 1; i < count; i++) {
+                if (at(offset, i, zero) < at(offset, i - 1, zero)) return false;
+            }
+            return (uint64_t)at(offset, count - 1, zero) == last;
+        };
+        // 服务器编号数组：每个值都在 [0, num_servers) 内
+        auto validServers = [&](uint64_t offset, uint64_t count) {
+            for (uint64_t i = 0; i < count; i++) {
+                int32_t s = at(offset, i, int32_t());
+                if (s < 0 || (uint32_t)s >= h.num_servers) return false;
+            }
+            return true;
+        };
+
+        if (!validBounds(h.day_start_offset, (uint64_t)h.num_days + 1, h.num_alarms, uint64_t()) ||
+            !validBounds(h.class_start_offset, (uint64_t)h.num_classes + 1, h.num_servers, uint32_t())) {
+            return false;
+        }
+        for (uint64_t s = 0; s < h.num_servers; s++) {
+            if (at(h.class_of_offset, s, uint32_t()) >= h.num_classes) return false;
+        }
+        return validServers(h.day_servers_offset, h.num_alarms) &&
+               validServers(h.class_servers_offset, h.num_servers) &&
+               validServers(h.candidate_order_offset, h.num_candidates);
+    }
+
+    void bindArrays() {
+        if (!storage.empty()) base = reinterpret_cast<const char*>(storage.data());
+        else if (snapshot.data()) base = snapshot.data();
+        if (!base) {
+            header = nullptr;
+            return;
+        }
+        header = reinterpret_cast<const AlarmIndexHeader*>(base);
+        day_mask_ = reinterpret_cast<const uint64_t*>(base + header->day_mask_offset);
+        first14_ = reinterpret_cast<const uint8_t*>(base + header->first14_offset);
+        class_of_ = reinterpret_cast<const uint32_t*>(base + header->class_of_offset);
+        class_mask_ = reinterpret_cast<const uint64_t*>(base + header->class_mask_offset);
+        class_start_ = reinterpret_cast<const uint32_t*>(base + header->class_start_offset);
+        class_servers_ = reinterpret_cast<const int32_t*>(base + header->class_servers_offset);
+        candidate_order_ = reinterpret_cast<const int32_t*>(base + header->candidate_order_offset);
+        day_start_ = reinterpret_cast<const uint64_t*>(base + header->day_start_offset);
+        day_servers_ = reinterpret_cast<const int32_t*>(base + header->day_servers_offset);
+    }
+
+    static uint32_t parseDeclared(const std::string& comment, const std::string& key) {
+        size_t pos = comment.find(key);
+        if (pos == std::string::npos) return 0;
+        unsigned long long value = strtoull(comment.c_str() + pos + key.size(), nullptr, 10);
+        return (uint32_t)std::min<unsigned long long>(value, UINT32_MAX);
+    }
+
+    static int64_t mtimeNs(const struct stat& st) {
+        return (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+    }
+
+    static uint64_t align8(uint64_t value) { return (value + 7) & ~7ULL; }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// 堆分配计数：替换全局 operator new/delete，统计进程内的分配次数和字节数，
+// 求解器用 AllocCounter 报告某一段代码（例如候选评估循环）里发生了多少次分配。
+//
+// 只有基准构建（-DALLOC_COUNTER，见 bench_solvers.py）才替换分配器，生产构建保留
+// 标准库的 operator new，计数恒为 0，输出里也不打印分配次数（看 ALLOC_COUNTER_ENABLED）。
+// 替换的 operator new 不能是 inline，所以只在定义了 ALLOC_COUNTER_REPLACE_NEW 的
+// 那一个翻译单元（main.cpp）里定义；其他文件包含这个头文件只使用 AllocCounter。
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef ALLOC_COUNTER
+inline constexpr bool ALLOC_COUNTER_ENABLED = true;
+#else
+inline constexpr bool ALLOC_COUNTER_ENABLED = false;
+#endif
+
+namespace alloc_counter_detail {
+inline std::atomic<uint64_t> allocations{0};
+inline std::atomic<uint64_t> allocated_bytes{0};
+
+inline void* allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+}  // namespace alloc_counter_detail
+
+#if defined(ALLOC_COUNTER) && defined(ALLOC_COUNTER_REPLACE_NEW)
+void* operator new(std::size_t size) { return alloc_counter_detail::allocate(size); }
+void* operator new[](std::size_t size) { return alloc_counter_detail::allocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+// 构造时记下当前计数，之后 count()/bytes() 返回这段时间内的分配
+class AllocCounter {
+private:
+    uint64_t start_count;
+    uint64_t start_bytes;
+
+public:
+    AllocCounter() { reset(); }
+
+    void reset() {
+        start_count = alloc_counter_detail::allocations.load(std::memory_order_relaxed);
+        start_bytes = alloc_counter_detail::allocated_bytes.load(std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return alloc_counter_detail::allocations.load(std::memory_order_relaxed) - start_count; }
+    uint64_t bytes() const { return alloc_counter_detail::allocated_bytes.load(std::memory_order_relaxed) - start_bytes; }
+
+    static uint64_t total() { return alloc_counter_detail::allocations.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,1231 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <queue>
+#include <unordered_set>
+#include <thread>
+#include <climits>
+#include <cstdlib>
+
+#include "solver_strategy.h"
+#include "result_cache.h"
+#include "allocation_state.h"
+#include "local_search.h"
+#include "complement_index.h"
+#include "coverage_greedy.h"
+#include "shared_incumbent.h"
+#include "gain_kernel.h"
+#include "trace.h"
+#include "metrics_stream.h"
+
+using namespace std;
+
+class ServerAllocationSolver : public SolverStrategy {
+private:
+    const AlarmIndex& alarm_index;
+    const vector<vector<int>>& daily_alarms; // daily_alarms[day] = list of server IDs
+    const int num_days;
+    const int total_engineer_days; // 7392 for 22 days
+    const int min_work_days;       // 6982 for 22 days
+    vector<int> server_to_engineer; // server_to_engineer[server_id] = engineer_id (-1 if unassigned)
+    const bool coverage_construction; // 用最大覆盖贪心代替目标工作天数分配构造初始解
+    double greedy_epsilon;            // 最大覆盖贪心第二阶段的 ε，0 表示精确贪心
+    
+public:
+    explicit ServerAllocationSolver(const ProblemData& data, bool coverage = false)
+        : alarm_index(data.alarm_index), daily_alarms(data.daily_alarms), num_days(data.num_days),
+          total_engineer_days(NUM_ENGINEERS * data.num_days), min_work_days(total_engineer_days - MAX_REST_DAYS),
+          server_to_engineer(NUM_SERVERS, -1),
+          coverage_construction(coverage), greedy_epsilon(0.0) {
+        // GREEDY_EPSILON=0.01 打开随机贪心（与 GAIN_KERNEL 一样通过环境变量调节）
+        if (const char* env = getenv("GREEDY_EPSILON")) greedy_epsilon = atof(env);
+    }
+    
+    string cacheParams() const override {
+        return coverage_construction ? "greedy_epsilon=" + to_string(greedy_epsilon) : string();
+    }
+    
+    Solution solve() override {
+        // 各阶段的结果都发布到无锁的 SharedIncumbent，只有严格更好的方案才会替换；
+        // 并行的阶段可以用同一个 incumbent 读最优分数剪枝或从当前最优重新出发
+        SharedIncumbent incumbent;
+        EpochHandle handle(incumbent.domain());
+        
+        // Step 1: Target work days allocation for precise distribution
+        cout << "Step 1: " << (coverage_construction ? "Maximum coverage" : "Target work days") << " allocation..." << endl;
+        MetricsStream& metrics = metricsStream();
+        metrics.setPhase("construction");
+        Solution initial(num_days);
+        {
+            TRACE_SPAN("construction", "allocation");
+            initial = coverage_construction ? maxCoverageAllocation() : optimalWorkDaysAllocation();
+        }
+        
+        if (!initial.valid) {
+            cout << "Failed to find valid initial allocation" << endl;
+            return Solution(num_days);
+        }
+        
+        unique_ptr<CompactSolution> compact = compactSolution(initial);
+        metrics.offerIncumbent(*compact);
+        incumbent.publish(handle, std::move(compact));
+        cout << "Initial solution - Rest days: " << initial.total_rest_days << endl;
+        
+        // Step 2: Constraint propagation optimization if needed
+        if (incumbent.improves(incumbentScore(0, MAX_REST_DAYS))) {
+            cout << "Step 2: Constraint propagation optimization..." << endl;
+            TRACE_SPAN("constraint_propagation", "allocation");
+            metrics.setPhase("constraint_propagation");
+            Solution optimized = constraintPropagationOptimization(initial);
+            
+            if (optimized.valid && incumbent.publish(handle, compactSolution(optimized))) {
+                cout << "Optimized solution - Rest days: " << optimized.total_rest_days << endl;
+            }
+        } else {
+            cout << "Target achieved! No further optimization needed." << endl;
+        }
+        
+        return incumbentSolution(incumbent, handle);
+    }
+    
+private:
+    unique_ptr<CompactSolution> compactSolution(const Solution& solution) const {
+        auto compact = make_unique<CompactSolution>();
+        compact->engineers = NUM_ENGINEERS;
+        compact->slots = MAX_SERVERS_PER_ENGINEER;
+        compact->rest_days = solution.total_rest_days;
+        compact->slot_server.assign((size_t)NUM_ENGINEERS * MAX_SERVERS_PER_ENGINEER, -1);
+        uint64_t first14 = alarm_index.first14Mask();
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            uint64_t work = 0;
+            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER && i < (int)solution.allocation[e].size(); i++) {
+                int server = solution.allocation[e][i];
+                compact->slot_server[(size_t)e * MAX_SERVERS_PER_ENGINEER + i] = server;
+                if (server >= 0) work |= alarm_index.mask(server);
+            }
+            if (!(work & first14)) compact->first14_missing++;
+        }
+        return compact;
+    }
+    
+    // 把当前最优展开成 Solution（daily_work 由调用方评估时重新计算）
+    Solution incumbentSolution(const SharedIncumbent& incumbent, EpochHandle& handle) const {
+        Solution solution(num_days);
+        CompactSolution best;
+        if (!incumbent.snapshot(handle, best)) return solution;
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) solution.allocation[e][i] = best.server(e, i);
+        }
+        solution.total_rest_days = best.rest_days;
+        solution.valid = true;
+        return solution;
+    }
+    
+    Solution maxCoverageAllocation() {
+        Solution solution(num_days);
+        solution.clearAllocation();
+        
+        // Reset server assignments
+        fill(server_to_engineer.begin(), server_to_engineer.end(), -1);
+        
+        cout << "=== Maximum Coverage Allocation Strategy ===" << endl;
+        cout << "Target: Exactly " << MAX_REST_DAYS << " rest days across all engineers" << endl;
+        cout << "Required work days: " << min_work_days << " out of " << total_engineer_days << endl;
+        
+        // Step 1: Analyze server-day patterns
+        map<int, vector<int>> server_days; // server -> days it appears
+        
+        for (int day = 0; day < num_days; day++) {
+            for (int server : daily_alarms[day]) {
+                server_days[server].push_back(day);
+            }
+        }
+        
+        cout << "Total unique servers: " << server_days.size() << endl;
+        
+        // Step 2: Calculate target work days per engineer
+        vector<int> engineer_target_work_days(NUM_ENGINEERS);
+        int base_work_days = min_work_days / NUM_ENGINEERS;
+        int extra_work_days = min_work_days % NUM_ENGINEERS;
+        
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            engineer_target_work_days[e] = base_work_days + (e < extra_work_days ? 1 : 0);
+        }
+        
+        cout << "Target work days per engineer: " << base_work_days << " to " << (base_work_days + 1) << endl;
+        
+        // Step 3: Two-phase allocation strategy
+        vector<int> engineer_load(NUM_ENGINEERS, 0);
+        vector<uint64_t> engineer_work_days(NUM_ENGINEERS, 0); // 工作天掩码
+        vector<bool> server_assigned(NUM_SERVERS, false);
+        
+        // Phase 1: Ensure all engineers have first 14 days coverage
+        cout << "Phase 1: Ensuring first 14 days coverage..." << endl;
+        traceInstant("phase 1", "construction");
+        
+        // Collect servers that appear in first 14 days
+        vector<int> first_14_servers;
+        for (auto& [server, days] : server_days) {
+            for (int day : days) {
+                if (day < FIRST_14_DAYS) {
+                    first_14_servers.push_back(server);
+                    break;
+                }
+            }
+        }
+        
+        cout << "Servers available in first 14 days: " << first_14_servers.size() << endl;
+        
+        // Round-robin assignment of first 14 days servers
+        int engineer_idx = 0;
+        for (int server : first_14_servers) {
+            if (server_assigned[server]) continue;
+            
+            // Find next engineer who needs first 14 days coverage and has capacity
+            int attempts = 0;
+            while (attempts < NUM_ENGINEERS) {
+                if (engineer_load[engineer_idx] < MAX_SERVERS_PER_ENGINEER) {
+                    // Check if this engineer already has first 14 days coverage
+                    bool has_first_14 = (engineer_work_days[engineer_idx] & first14DayMask()) != 0;
+                    
+                    if (!has_first_14) {
+                        // Assign this server to this engineer
+                        server_to_engineer[server] = engineer_idx;
+                        solution.allocation[engineer_idx].push_back(server);
+                        engineer_load[engineer_idx]++;
+                        server_assigned[server] = true;
+                        
+                        // Update work days
+                        engineer_work_days[engineer_idx] |= serverDayMask(server);
+                        
+                        engineer_idx = (engineer_idx + 1) % NUM_ENGINEERS;
+                        break;
+                    }
+                }
+                engineer_idx = (engineer_idx + 1) % NUM_ENGINEERS;
+                attempts++;
+            }
+        }
+        
+        // Phase 2: Distribute remaining servers to maximize coverage
+        cout << "Phase 2: Maximizing coverage with remaining servers..." << endl;
+        traceInstant("phase 2", "construction");
+        
+        // Sort remaining servers by coverage potential
+        vector<pair<int, int>> server_priority;
+        for (auto& [server, days] : server_days) {
+            if (!server_assigned[server]) {
+                int priority = days.size() * 100; // Base priority on number of days
+                
+                // Bonus for servers that appear in first 14 days
+                for (int day : days) {
+                    if (day < FIRST_14_DAYS) {
+                        priority += 50;
+                        break;
+                    }
+                }
+                
+                server_priority.push_back({priority, server});
+            }
+        }
+        
+        sort(server_priority.rbegin(), server_priority.rend());
+        
+        vector<int> order, capacity(NUM_ENGINEERS);
+        for (auto& [priority, server] : server_priority) order.push_back(server);
+        for (int e = 0; e < NUM_ENGINEERS; e++) capacity[e] = MAX_SERVERS_PER_ENGINEER - engineer_load[e];
+        
+        // Gain for handing this server to engineer e; only ever decreases as e gains servers
+        auto score = [&](int e, int server) {
+            if (engineer_load[e] >= MAX_SERVERS_PER_ENGINEER) return INT_MIN;
+            
+            int new_work_days = __builtin_popcountll(serverDayMask(server) & ~engineer_work_days[e]);
+            int gain = new_work_days * 100;
+            
+            // Bonus for engineers who need more work days
+            int current_work_days = __builtin_popcountll(engineer_work_days[e]);
+            int work_days_needed = engineer_target_work_days[e] - current_work_days;
+            if (work_days_needed > 0) {
+                gain += work_days_needed * 50;
+            }
+            
+            // Penalty for exceeding target
+            if (current_work_days + new_work_days > engineer_target_work_days[e]) {
+                gain -= (current_work_days + new_work_days - engineer_target_work_days[e]) * 25;
+            }
+            return gain;
+        };
+        // Same scores for every engineer at once: the new-day counts come from the SIMD gain kernel
+        // and the target bonus/penalty is combined over contiguous per-engineer arrays
+        vector<int32_t> current_work(NUM_ENGINEERS);
+        for (int e = 0; e < NUM_ENGINEERS; e++) current_work[e] = __builtin_popcountll(engineer_work_days[e]);
+        auto score_all = [&](int server, int32_t* scores) {
+            coverageGains(engineer_work_days.data(), NUM_ENGINEERS, serverDayMask(server), scores);
+            for (int e = 0; e < NUM_ENGINEERS; e++) {
+                int new_work_days = scores[e];
+                int current_work_days = current_work[e];
+                int target = engineer_target_work_days[e];
+                int gain = new_work_days * 100 + max(0, target - current_work_days) * 50 -
+                           max(0, current_work_days + new_work_days - target) * 25;
+                scores[e] = engineer_load[e] >= MAX_SERVERS_PER_ENGINEER ? INT_MIN : gain;
+            }
+        };
+        auto assign = [&](int e, int server) {
+            server_to_engineer[server] = e;
+            solution.allocation[e].push_back(server);
+            engineer_load[e]++;
+            server_assigned[server] = true;
+            engineer_work_days[e] |= serverDayMask(server);
+            current_work[e] = __builtin_popcountll(engineer_work_days[e]);
+        };
+        
+        // Assign remaining servers using greedy approach (exact, or stochastic when GREEDY_EPSILON > 0)
+        CoverageGreedyOptions options;
+        options.epsilon = greedy_epsilon;
+        options.threads = solverPool().concurrency();
+        CoverageGreedyStats greedy = coverageGreedy(order, NUM_ENGINEERS, capacity, options, score, assign, score_all);
+        
+        cout << (greedy_epsilon > 0 ? "Stochastic" : "Exact") << " greedy";
+        if (greedy_epsilon > 0) cout << " (epsilon " << greedy_epsilon << ", sample <= " << greedy.max_sample << ")";
+        cout << ": assigned " << greedy.assigned << " servers, " << greedy.evaluations << " evaluations, "
+             << greedy.recomputed << " re-evaluated" << endl;
+        metricsStream().setStat("greedy_evaluations", greedy.evaluations);
+        metricsStream().setStat("greedy_recomputed", greedy.recomputed);
+        
+        // Pad allocations with -1
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            while (solution.allocation[e].size() < MAX_SERVERS_PER_ENGINEER) {
+                solution.allocation[e].push_back(-1);
+            }
+        }
+        
+        // Calculate daily work and rest days
+        calculateDailyWork(solution);
+        printConstraintReport(solution);
+        
+        return solution;
+    }
+    
+    Solution mathematicalConstraintAllocation() {
+        Solution solution(num_days);
+        solution.clearAllocation();
+        
+        // Reset server assignments
+        fill(server_to_engineer.begin(), server_to_engineer.end(), -1);
+        
+        cout << "=== Mathematical Constraint Allocation ===" << endl;
+        cout << "Target: Exactly " << MAX_REST_DAYS << " rest days across all engineers" << endl;
+        cout << "Required work days: " << min_work_days << " out of " << total_engineer_days << endl;
+        
+        // Step 1: Analyze server-day patterns
+        map<int, vector<int>> server_days;
+        vector<int> day_server_count(num_days, 0);
+        
+        for (int day = 0; day < num_days; day++) {
+            day_server_count[day] = daily_alarms[day].size();
+            for (int server : daily_alarms[day]) {
+                server_days[server].push_back(day);
+            }
+        }
+        
+        cout << "Total unique servers: " << server_days.size() << endl;
+        
+        // Step 2: Calculate exact work day targets
+        int target_work_days_per_engineer = min_work_days / NUM_ENGINEERS;
+        int engineers_with_extra_day = min_work_days % NUM_ENGINEERS;
+        
+        cout << "Target work days: " << target_work_days_per_engineer 
+             << " (+" << engineers_with_extra_day << " engineers get +1)" << endl;
+        
+        // Step 3: Greedy allocation with strict mathematical constraints
+        vector<int> engineer_load(NUM_ENGINEERS, 0);
+        vector<set<int>> engineer_work_days(NUM_ENGINEERS);
+        vector<bool> server_assigned(NUM_SERVERS, false);
+        
+        // Phase 1: Ensure first 14 days constraint
+        cout << "Phase 1: Ensuring first 14 days coverage..." << endl;
+        traceInstant("phase 1", "construction");
+        
+        vector<int> first_14_servers;
+        for (auto& [server, days] : server_days) {
+            for (int day : days) {
+                if (day < FIRST_14_DAYS) {
+                    first_14_servers.push_back(server);
+                    break;
+                }
+            }
+        }
+        
+        // Round-robin assignment for first 14 days
+        for (int i = 0; i < first_14_servers.size() && i < NUM_ENGINEERS; i++) {
+            int server = first_14_servers[i];
+            int engineer = i % NUM_ENGINEERS;
+            
+            if (engineer_load[engineer] < MAX_SERVERS_PER_ENGINEER) {
+                server_to_engineer[server] = engineer;
+                solution.allocation[engineer].push_back(server);
+                engineer_load[engineer]++;
+                server_assigned[server] = true;
+                
+                for (int day : server_days[server]) {
+                    engineer_work_days[engineer].insert(day);
+                }
+            }
+        }
+        
+        // Phase 2: Distribute remaining servers to meet exact work day targets
+        cout << "Phase 2: Meeting exact work day targets..." << endl;
+        traceInstant("phase 2", "construction");
+        
+        // Sort engineers by current work day deficit
+        vector<pair<int, int>> engineer_deficit; // {deficit, engineer_id}
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            int target = target_work_days_per_engineer + (e < engineers_with_extra_day ? 1 : 0);
+            int current = engineer_work_days[e].size();
+            int deficit = target - current;
+            if (deficit > 0) {
+                engineer_deficit.push_back({deficit, e});
+            }
+        }
+        sort(engineer_deficit.rbegin(), engineer_deficit.rend());
+        
+        // Sort remaining servers by coverage potential
+        vector<pair<int, int>> server_priority;
+        for (auto& [server, days] : server_days) {
+            if (!server_assigned[server]) {
+                int priority = days.size() * 100;
+                // Bonus for first 14 days
+                for (int day : days) {
+                    if (day < FIRST_14_DAYS) {
+                        priority += 200;
+                        break;
+                    }
+                }
+                server_priority.push_back({priority, server});
+            }
+        }
+        sort(server_priority.rbegin(), server_priority.rend());
+        
+        // Assign servers to engineers with highest deficit
+        for (auto& [priority, server] : server_priority) {
+            if (server_assigned[server]) continue;
+            
+            int best_engineer = -1;
+            int best_gain = -1;
+            
+            // Prioritize engineers with work day deficit
+            for (auto& [deficit, engineer] : engineer_deficit) {
+                if (engineer_load[engineer] >= MAX_SERVERS_PER_ENGINEER) continue;
+                
+                int gain = 0;
+                for (int day : server_days[server]) {
+                    if (engineer_work_days[engineer].find(day) == engineer_work_days[engineer].end()) {
+                        gain++;
+                    }
+                }
+                
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_engineer = engineer;
+                }
+            }
+            
+            if (best_engineer != -1 && best_gain > 0) {
+                server_to_engineer[server] = best_engineer;
+                solution.allocation[best_engineer].push_back(server);
+                engineer_load[best_engineer]++;
+                server_assigned[server] = true;
+                
+                for (int day : server_days[server]) {
+                    engineer_work_days[best_engineer].insert(day);
+                }
+                
+                // Update deficit list
+                engineer_deficit.clear();
+                for (int e = 0; e < NUM_ENGINEERS; e++) {
+                    int target = target_work_days_per_engineer + (e < engineers_with_extra_day ? 1 : 0);
+                    int current = engineer_work_days[e].size();
+                    int deficit = target - current;
+                    if (deficit > 0) {
+                        engineer_deficit.push_back({deficit, e});
+                    }
+                }
+                sort(engineer_deficit.rbegin(), engineer_deficit.rend());
+            }
+        }
+        
+        // Phase 3: Fill remaining capacity
+        cout << "Phase 3: Filling remaining capacity..." << endl;
+        traceInstant("phase 3", "construction");
+        
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            while (engineer_load[e] < MAX_SERVERS_PER_ENGINEER) {
+                int best_server = -1;
+                int best_gain = 0;
+                
+                for (auto& [server, days] : server_days) {
+                    if (!server_assigned[server]) {
+                        int gain = 0;
+                        for (int day : days) {
+                            if (engineer_work_days[e].find(day) == engineer_work_days[e].end()) {
+                                gain++;
+                            }
+                        }
+                        if (gain > best_gain) {
+                            best_gain = gain;
+                            best_server = server;
+                        }
+                    }
+                }
+                
+                if (best_server == -1) break;
+                
+                server_to_engineer[best_server] = e;
+                solution.allocation[e].push_back(best_server);
+                engineer_load[e]++;
+                server_assigned[best_server] = true;
+                
+                for (int day : server_days[best_server]) {
+                    engineer_work_days[e].insert(day);
+                }
+            }
+        }
+        
+        // Pad allocations with -1
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            while (solution.allocation[e].size() < MAX_SERVERS_PER_ENGINEER) {
+                solution.allocation[e].push_back(-1);
+            }
+        }
+        
+        // Calculate daily work and rest days
+        calculateDailyWork(solution);
+        printConstraintReport(solution);
+        
+        return solution;
+    }
+    
+    int calculateCoverageGain(int engineer, int server, const vector<set<int>>& engineer_work_days,
+                             const map<int, vector<int>>& server_days, const vector<int>& engineer_target_work_days) {
+        int gain = 0;
+        int new_work_days = 0;
+        bool provides_first_14 = false;
+        
+        // Count new work days this server would provide
+        for (int day : server_days.at(server)) {
+            if (engineer_work_days[engineer].find(day) == engineer_work_days[engineer].end()) {
+                new_work_days++;
+                if (day < FIRST_14_DAYS) {
+                    provides_first_14 = true;
+                }
+            }
+        }
+        
+        // Base gain from new work days
+        gain += new_work_days * 100;
+        
+        // Bonus for first 14 days coverage
+        if (provides_first_14) {
+            bool has_first_14_work = false;
+            for (int day : engineer_work_days[engineer]) {
+                if (day < FIRST_14_DAYS) {
+                    has_first_14_work = true;
+                    break;
+                }
+            }
+            if (!has_first_14_work) {
+                gain += 1000; // Critical bonus for first 14 days constraint
+            } else {
+                gain += 200; // Smaller bonus for additional first 14 days coverage
+            }
+        }
+        
+        // Bonus for engineers who need more work days to reach target
+        int current_work_days = engineer_work_days[engineer].size();
+        int work_days_needed = engineer_target_work_days[engineer] - current_work_days;
+        if (work_days_needed > 0) {
+            gain += work_days_needed * 50;
+        }
+        
+        // Penalty for exceeding target (to encourage even distribution)
+        int potential_work_days = current_work_days + new_work_days;
+        if (potential_work_days > engineer_target_work_days[engineer]) {
+            gain -= (potential_work_days - engineer_target_work_days[engineer]) * 25;
+        }
+        
+        return gain;
+    }
+    
+    int findOptimalEngineerForConstraints(int server, const vector<int>& engineer_load,
+                                         const vector<set<int>>& engineer_work_days,
+                                         const vector<int>& engineer_target_work_days,
+                                         const map<int, vector<int>>& server_days) {
+        int best_engineer = -1;
+        int best_score = -1;
+        
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            if (engineer_load[e] >= MAX_SERVERS_PER_ENGINEER) continue;
+            
+            int score = 0;
+            
+            // Priority 1: Engineers who need more work days to reach target
+            int current_work_days = engineer_work_days[e].size();
+            int work_days_needed = engineer_target_work_days[e] - current_work_days;
+            if (work_days_needed > 0) {
+                score += work_days_needed * 1000;
+            }
+            
+            // Priority 2: New work days this server would provide
+            int new_work_days = 0;
+            for (int day : server_days.at(server)) {
+                if (engineer_work_days[e].find(day) == engineer_work_days[e].end()) {
+                    new_work_days++;
+                    if (day < FIRST_14_DAYS) {
+                        score += 500; // Extra bonus for first 14 days
+                    }
+                }
+            }
+            score += new_work_days * 100;
+            
+            // Priority 3: Load balancing
+            score += (MAX_SERVERS_PER_ENGINEER - engineer_load[e]) * 10;
+            
+            // Priority 4: First 14 days constraint
+            bool has_first_14_work = false;
+            for (int day : engineer_work_days[e]) {
+                if (day < FIRST_14_DAYS) {
+                    has_first_14_work = true;
+                    break;
+                }
+            }
+            
+            if (!has_first_14_work) {
+                for (int day : server_days.at(server)) {
+                    if (day < FIRST_14_DAYS) {
+                        score += 2000; // Critical for first 14 days constraint
+                        break;
+                    }
+                }
+            }
+            
+            if (score > best_score) {
+                best_score = score;
+                best_engineer = e;
+            }
+        }
+        
+        return best_engineer;
+    }
+    
+    // 服务器在求解天数范围内的警报天掩码（与 daily_alarms 的内容一致）
+    uint64_t serverDayMask(int server) const {
+        if (server < 0 || server >= alarm_index.numServers()) return 0;
+        return alarm_index.mask(server) & (num_days >= 64 ? ~0ULL : (1ULL << num_days) - 1);
+    }
+    
+    uint64_t first14DayMask() const {
+        return (1ULL << FIRST_14_DAYS) - 1;
+    }
+    
+    // 由 server_to_engineer 重新计算 daily_work、总休息天数和是否满足前14天约束，不输出
+    void calculateDailyWork(Solution& solution) {
+        TRACE_SPAN("calculate_daily_work", "allocation");
+        PerfScope perf(PERF_VALIDATION);
+        solution.total_rest_days = 0;
+        
+        // Reset daily work
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            fill(solution.daily_work[e].begin(), solution.daily_work[e].end(), false);
+        }
+        
+        // Mark work days based on server alarms
+        for (int day = 0; day < num_days; day++) {
+            for (int server : daily_alarms[day]) {
+                int engineer = server_to_engineer[server];
+                if (engineer != -1) {
+                    solution.daily_work[engineer][day] = true;
+                }
+            }
+        }
+        
+        // Count rest days and validate constraints
+        solution.valid = true;
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            bool works_in_first_14 = false;
+            for (int day = 0; day < num_days; day++) {
+                if (solution.daily_work[e][day]) {
+                    if (day < FIRST_14_DAYS) {
+                        works_in_first_14 = true;
+                    }
+                } else {
+                    solution.total_rest_days++;
+                }
+            }
+            if (!works_in_first_14) {
+                solution.valid = false;
+            }
+        }
+    }
+    
+    // 约束报告，只在构造和热启动结束时输出一次
+    void printConstraintReport(const Solution& solution) const {
+        vector<int> engineer_rest_days(NUM_ENGINEERS, 0);
+        vector<int> engineer_work_days(NUM_ENGINEERS, 0);
+        int engineers_with_first_14_work = 0;
+        
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            bool works_in_first_14 = false;
+            
+            // Check first 14 days constraint and count work/rest days
+            for (int day = 0; day < num_days; day++) {
+                if (solution.daily_work[e][day]) {
+                    engineer_work_days[e]++;
+                    if (day < FIRST_14_DAYS) {
+                        works_in_first_14 = true;
+                    }
+                } else {
+                    engineer_rest_days[e]++;
+                }
+            }
+            
+            if (works_in_first_14) {
+                engineers_with_first_14_work++;
+            } else {
+                cout << "Engineer " << e << " has no work in first 14 days" << endl;
+            }
+        }
+        
+        // Detailed constraint analysis
+        cout << "=== Constraint Analysis ===" << endl;
+        cout << "Total rest days: " << solution.total_rest_days << " / " << MAX_REST_DAYS << endl;
+        cout << "Engineers with first 14 days work: " << engineers_with_first_14_work << " / " << NUM_ENGINEERS << endl;
+        
+        // Find engineers with most rest days (potential optimization targets)
+        vector<pair<int, int>> engineer_rest_pairs;
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            engineer_rest_pairs.push_back({engineer_rest_days[e], e});
+        }
+        sort(engineer_rest_pairs.rbegin(), engineer_rest_pairs.rend());
+        
+        cout << "Top 5 engineers with most rest days:" << endl;
+        for (int i = 0; i < min(5, (int)engineer_rest_pairs.size()); i++) {
+            int rest_days = engineer_rest_pairs[i].first;
+            int engineer = engineer_rest_pairs[i].second;
+            cout << "  Engineer " << engineer << ": " << rest_days << " rest days, " 
+                 << engineer_work_days[engineer] << " work days" << endl;
+        }
+        
+        // Calculate constraint satisfaction
+        bool first_14_satisfied = (engineers_with_first_14_work == NUM_ENGINEERS);
+        bool rest_days_satisfied = (solution.total_rest_days <= MAX_REST_DAYS);
+        
+        cout << "First 14 days constraint: " << (first_14_satisfied ? "SATISFIED" : "VIOLATED") << endl;
+        cout << "Rest days constraint: " << (rest_days_satisfied ? "SATISFIED" : "VIOLATED") << endl;
+        
+        if (rest_days_satisfied && first_14_satisfied) {
+            cout << "*** ALL CONSTRAINTS SATISFIED! ***" << endl;
+        } else {
+            cout << "*** CONSTRAINT VIOLATIONS DETECTED ***" << endl;
+            if (!rest_days_satisfied) {
+                cout << "  - Excess rest days: " << (solution.total_rest_days - MAX_REST_DAYS) << endl;
+            }
+            if (!first_14_satisfied) {
+                cout << "  - Engineers missing first 14 days work: " << (NUM_ENGINEERS - engineers_with_first_14_work) << endl;
+            }
+        }
+        
+        cout << "Solution validation - Valid: " << solution.valid 
+             << ", Total rest days: " << solution.total_rest_days << endl;
+    }
+    
+    Solution constraintPropagationOptimization(Solution solution) {
+        cout << "=== Starting Aggressive Rest Day Reduction ===" << endl;
+        cout << "Current rest days: " << solution.total_rest_days << " / Target: " << MAX_REST_DAYS << endl;
+        cout << "Need to reduce " << (solution.total_rest_days - MAX_REST_DAYS) << " rest days" << endl;
+        
+        if (solution.total_rest_days <= MAX_REST_DAYS) {
+            cout << "Already within constraint limits, skipping optimization" << endl;
+            return solution;
+        }
+        
+        // Step 1: Analyze current allocation efficiency
+        map<int, vector<int>> server_days;
+        for (int day = 0; day < num_days; day++) {
+            for (int server : daily_alarms[day]) {
+                server_days[server].push_back(day);
+            }
+        }
+        
+        // Step 2: Identify engineers with excessive rest days
+        vector<pair<int, int>> engineer_rest_days; // {rest_days, engineer_id}
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            int rest_days = 0;
+            for (int day = 0; day < num_days; day++) {
+                if (!solution.daily_work[e][day]) rest_days++;
+            }
+            engineer_rest_days.push_back({rest_days, e});
+        }
+        sort(engineer_rest_days.rbegin(), engineer_rest_days.rend());
+        
+        cout << "Engineers with most rest days:" << endl;
+        for (int i = 0; i < min(10, (int)engineer_rest_days.size()); i++) {
+            cout << "  Engineer " << engineer_rest_days[i].second 
+                 << ": " << engineer_rest_days[i].first << " rest days" << endl;
+        }
+        
+        // 与 solution.allocation 按槽位一一对应的掩码状态。每轮迭代是一个事务：
+        // 移动直接改 solution.allocation / server_to_engineer，daily_work 和总数保持
+        // 迭代开始时的值；没有改善就按撤销日志回滚，不再整体复制 Solution
+        AllocationState state;
+        state.reset(alarm_index, NUM_ENGINEERS, NUM_SERVERS, MAX_SERVERS_PER_ENGINEER, num_days);
+        state.loadSlots(solution.allocation);
+        
+        // 按休息天倒排的候选服务器，只保留至少能填补两个休息天的。不截断：
+        // 没有归属或移走会破坏原工程师前14天约束的候选会被跳过，截断后可能漏掉后面可用的候选
+        ComplementIndex complements;
+        complements.build(state, 2, 0);
+        
+        // Step 3: Aggressive reallocation strategy
+        for (int iteration = 0; iteration < 50; iteration++) {
+            TRACE_SPAN("propagation_iteration", "allocation");
+            size_t mark = state.checkpoint();
+            bool improved = false;
+            
+            // Focus on engineers with most rest days
+            for (int i = 0; i < min(50, (int)engineer_rest_days.size()); i++) {
+                int engineer = engineer_rest_days[i].second;
+                int current_rest = engineer_rest_days[i].first;
+                
+                if (current_rest <= 2) break; // Skip engineers already at target
+                
+                // Try to find better server assignments for this engineer
+                if (aggressiveServerReallocation(solution, state, complements, engineer, server_days)) {
+                    improved = true;
+                }
+            }
+            
+            // 交换和搬移不再逐对尝试：一次批量扫描评估所有工程师的移动，互不冲突的改进一起提交
+            if (tryServerRedistribution(solution, state)) {
+                improved = true;
+            }
+            
+            if (state.first14_missing == 0 && state.total_rest_days < solution.total_rest_days) {
+                commitMoves(solution, state, mark);
+                traceCounter("rest_days", solution.total_rest_days);
+                metricsStream().offerIncumbent(state);
+                cout << "Iteration " << iteration << ": Rest days reduced to " << solution.total_rest_days << endl;
+                
+                // Update engineer rest days for next iteration
+                engineer_rest_days.clear();
+                for (int e = 0; e < NUM_ENGINEERS; e++) {
+                    engineer_rest_days.push_back({state.restDays(e), e});
+                }
+                sort(engineer_rest_days.rbegin(), engineer_rest_days.rend());
+                
+                if (solution.total_rest_days <= MAX_REST_DAYS) {
+                    cout << "TARGET ACHIEVED! Rest days: " << solution.total_rest_days << endl;
+                    break;
+                }
+            } else {
+                rollbackMoves(solution, state, mark);
+            }
+            
+            if (!improved) {
+                cout << "No further improvement possible in iteration " << iteration << endl;
+                break;
+            }
+        }
+        
+        cout << "Final rest days: " << solution.total_rest_days << " / " << MAX_REST_DAYS << endl;
+        
+        return solution;
+    }
+    
+    // 提交 state 上从 mark 开始的事务：只同步被改动工程师的 daily_work 和总数
+    void commitMoves(Solution& solution, AllocationState& state, size_t mark) {
+        vector<int> engineers, servers;
+        state.changedSince(mark, engineers, servers);
+        state.commit();
+        
+        for (int e : engineers) {
+            for (int day = 0; day < num_days; day++) {
+                solution.daily_work[e][day] = (state.work_mask[e] >> day) & 1;
+            }
+        }
+        solution.total_rest_days = state.total_rest_days;
+        solution.valid = state.first14_missing == 0;
+    }
+    
+    // 回滚 state 上从 mark 开始的事务，并把被改动的槽位和服务器归属恢复到 solution
+    void rollbackMoves(Solution& solution, AllocationState& state, size_t mark) {
+        vector<int> engineers, servers;
+        state.changedSince(mark, engineers, servers);
+        state.rollback(mark);
+        
+        for (int e : engineers) {
+            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
+                solution.allocation[e][i] = state.slotServer(e, i);
+            }
+        }
+        for (int server : servers) {
+            server_to_engineer[server] = state.owner[server];
+        }
+    }
+    
+    // 把 solution 中 engineer 第 slot 个槽位改成 server，同时更新 state 和 server_to_engineer
+    void setSlot(Solution& solution, AllocationState& state, int engineer, int slot, int server) {
+        int old_server = solution.allocation[engineer][slot];
+        state.clear(engineer, slot);
+        if (old_server != -1 && server_to_engineer[old_server] == engineer) server_to_engineer[old_server] = -1;
+        if (server != -1) {
+            state.place(engineer, slot, server);
+            server_to_engineer[server] = engineer;
+        }
+        solution.allocation[engineer][slot] = server;
+    }
+    
+    bool aggressiveServerReallocation(Solution& solution, AllocationState& state, ComplementIndex& complements,
+                                      int engineer, const map<int, vector<int>>& server_days) {
+        bool improved = false;
+        
+        // Only servers that fire on one of this engineer's rest days can add work days
+        uint64_t rest_mask = 0;
+        for (int day = 0; day < num_days; day++) {
+            if (!solution.daily_work[engineer][day]) rest_mask |= 1ULL << day;
+        }
+        
+        // Try to reassign top servers to this engineer
+        for (auto& [gain, server] : complements.complements(rest_mask)) {
+            if (state.load[engineer] >= MAX_SERVERS_PER_ENGINEER) break; // No free slot left
+            if (server_to_engineer[server] == engineer) continue; // Already assigned to this engineer
+            
+            int current_owner = server_to_engineer[server];
+            if (current_owner == -1) continue;
+            
+            // Check if we can remove this server from current owner without violating first 14 days
+            bool can_remove = true;
+            
+            // Check first 14 days constraint for current owner
+            bool would_lose_first_14 = true;
+            for (int day = 0; day < FIRST_14_DAYS; day++) {
+                if (solution.daily_work[current_owner][day]) {
+                    bool has_other_server_for_day = false;
+                    for (int s : solution.allocation[current_owner]) {
+                        if (s == server || s == -1) continue;
+                        for (int server_day : server_days.at(s)) {
+                            if (server_day == day) {
+                                has_other_server_for_day = true;
+                                break;
+                            }
+                        }
+                        if (has_other_server_for_day) break;
+                    }
+                    if (has_other_server_for_day) {
+                        would_lose_first_14 = false;
+                        break;
+                    }
+                }
+            }
+            
+            if (would_lose_first_14) {
+                can_remove = false; // Would violate first 14 days constraint
+            }
+            
+            if (can_remove) {
+                // Check if target engineer has capacity
+                int target_load = 0;
+                for (int s : solution.allocation[engineer]) {
+                    if (s != -1) target_load++;
+                }
+                
+                if (target_load < MAX_SERVERS_PER_ENGINEER) {
+                    // Make the reassignment: remove server from current owner,
+                    // then add it to the first empty slot of the target engineer
+                    setSlot(solution, state, current_owner, state.slotOf(current_owner, server), -1);
+                    setSlot(solution, state, engineer, state.freeSlot(engineer), server);
+                    improved = true;
+                }
+            }
+        }
+        
+        return improved;
+    }
+    
+    // 一次批量扫描：并行评估所有工程师的搬移和交换，一起提交互不冲突的改进。
+    // 嵌套在迭代的事务里，这里只把改动同步回 solution.allocation 和 server_to_engineer，
+    // 是否保留由迭代结束时的检查决定
+    bool tryServerRedistribution(Solution& solution, AllocationState& state) {
+        size_t mark = state.checkpoint();
+        vector<int> batch(NUM_ENGINEERS);
+        for (int e = 0; e < NUM_ENGINEERS; e++) batch[e] = e;
+        SweepStats sweep = parallelMoveSweep(state, batch, solverPool().concurrency());
+        
+        // 批量提交的移动不一定保持槽位位置，把改动过的工程师整行同步回来
+        vector<int> engineers, servers;
+        state.changedSince(mark, engineers, servers);
+        state.commit();
+        for (int e : engineers) {
+            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
+                solution.allocation[e][i] = state.slotServer(e, i);
+            }
+        }
+        for (int server : servers) {
+            server_to_engineer[server] = state.owner[server];
+        }
+        return sweep.applied > 0;
+    }
+    
+    // 新的精确工作天数目标分配算法
+    Solution optimalWorkDaysAllocation() {
+        Solution solution(num_days);
+        solution.clearAllocation();
+        
+        // Reset server assignments
+        fill(server_to_engineer.begin(), server_to_engineer.end(), -1);
+        
+        cout << "\n=== Target Work Days Allocation Strategy ===" << endl;
+        cout << "Target: 74 engineers work 20 days (2 rest), 262 engineers work 21 days (1 rest)" << endl;
+        cout << "Total target rest days: 74*2 + 262*1 = " << (74*2 + 262*1) << endl;
+        
+        // 第一阶段：确保前14天覆盖
+        cout << "\nPhase 1: Ensuring first 14 days coverage..." << endl;
+        traceInstant("phase 1", "construction");
+        
+        // 收集前14天的所有服务器
+        set<int> first_14_servers;
+        for (int day = 0; day < 14; day++) {
+            for (int server : daily_alarms[day]) {
+                first_14_servers.insert(server);
+            }
+        }
+        
+        cout << "Available servers in first 14 days: " << first_14_servers.size() << endl;
+        
+        // 为每个工程师分配前14天的服务器（确保不重复分配）
+        vector<int> first_14_list(first_14_servers.begin(), first_14_servers.end());
+        vector<int> engineer_load(NUM_ENGINEERS, 0);
+        
+        // 使用轮询方式分配，但确保每个服务器只分配一次
+        int server_index = 0;
+        for (int engineer = 0; engineer < NUM_ENGINEERS && server_index < first_14_list.size(); engineer++) {
+            int server = first_14_list[server_index];
+            solution.allocation[engineer].push_back(server);
+            server_to_engineer[server] = engineer;
+            engineer_load[engineer]++;
+            server_index++;
+        }
+        
+        cout << "Phase 1 completed: All engineers have first 14 days coverage" << endl;
+        
+        // 第二阶段：精确工作天数分配
+        cout << "\nPhase 2: Precise work days allocation..." << endl;
+        traceInstant("phase 2", "construction");
+        
+        // 设定目标工作天数
+        vector<int> target_work_days(NUM_ENGINEERS);
+        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+            if (engineer < 74) {
+                target_work_days[engineer] = 20;  // 前74个工程师工作20天
+            } else {
+                target_work_days[engineer] = 21;  // 其余262个工程师工作21天
+            }
+        }
+        
+        // 构建服务器-天数映射
+        map<int, vector<int>> server_days;
+        for (int day = 0; day < num_days; day++) {
+            for (int server : daily_alarms[day]) {
+                server_days[server].push_back(day);
+            }
+        }
+        
+        // 收集所有可用服务器（按覆盖天数排序）
+        vector<pair<int, int>> server_coverage;  // (server_id, coverage_days)
+        for (auto& [server, days] : server_days) {
+            if (server_to_engineer[server] == -1) {
+                server_coverage.push_back({server, days.size()});
+            }
+        }
+        
+        // 按覆盖天数降序排序
+        sort(server_coverage.begin(), server_coverage.end(), 
+             [](const pair<int, int>& a, const pair<int, int>& b) {
+                 return a.second > b.second;
+             });
+        
+        cout << "Available servers for allocation: " << server_coverage.size() << endl;
+        
+        // 候选服务器的天掩码按 server_coverage 的顺序连续存放，分配出去的置 0，
+        // 这样增益内核扫描的顺序和平局规则都与逐个比较相同
+        vector<uint64_t> coverage_masks(server_coverage.size());
+        for (size_t i = 0; i < server_coverage.size(); i++) {
+            coverage_masks[i] = serverDayMask(server_coverage[i].first);
+        }
+        
+        // 迭代分配服务器直到达到目标工作天数
+        TRACE_SPAN("precise_work_days", "allocation");
+        bool progress = true;
+        int iteration = 0;
+        int assigned = 0;
+        while (progress && iteration < 1000) {
+            progress = false;
+            iteration++;
+            
+            // 计算当前工作天数
+            vector<uint64_t> engineer_work_days(NUM_ENGINEERS, 0);
+            for (int e = 0; e < NUM_ENGINEERS; e++) {
+                for (int server : solution.allocation[e]) {
+                    if (server != -1) {
+                        engineer_work_days[e] |= serverDayMask(server);
+                    }
+                }
+            }
+            
+            // 找到最需要更多工作天数的工程师
+            vector<pair<int, int>> engineer_deficit;  // (deficit, engineer_id)
+            for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+                int current_work = __builtin_popcountll(engineer_work_days[engineer]);
+                int deficit = target_work_days[engineer] - current_work;
+                if (deficit > 0 && engineer_load[engineer] < MAX_SERVERS_PER_ENGINEER) {
+                    engineer_deficit.push_back({deficit, engineer});
+                }
+            }
+            
+            // 按缺口降序排序
+            sort(engineer_deficit.rbegin(), engineer_deficit.rend());
+            
+            // 为缺口最大的工程师分配最佳服务器
+            for (auto& [deficit, engineer] : engineer_deficit) {
+                if (engineer_load[engineer] >= MAX_SERVERS_PER_ENGINEER) {
+                    continue;
+                }
+                
+                // 计算分配每个服务器会增加多少工作天数，取第一个最大值
+                GainArgmax best = bestServerGain(coverage_masks.data(), coverage_masks.size(),
+                                                 engineer_work_days[engineer]);
+                int best_server = best.index == -1 ? -1 : server_coverage[best.index].first;
+                int best_gain = best.score;
+                
+                if (best_server != -1 && best_gain > 0) {
+                    coverage_masks[best.index] = 0;
+                    solution.allocation[engineer].push_back(best_server);
+                    server_to_engineer[best_server] = engineer;
+                    engineer_load[engineer]++;
+                    progress = true;
+                    
+                    assigned++;
+                    // 继续为其他工程师分配服务器，不要break
+                }
+            }
+            
+            // 每轮的进度只记到追踪里，不再输出到控制台
+            if (traceEnabled()) {
+                int engineers_at_target = 0;
+                for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+                    int current_work = __builtin_popcountll(engineer_work_days[engineer]);
+                    if (current_work >= target_work_days[engineer]) {
+                        engineers_at_target++;
+                    }
+                }
+                traceCounter("servers_assigned", assigned);
+                traceCounter("engineers_at_target", engineers_at_target);
+            }
+        }
+        
+        cout << "Phase 2 completed after " << iteration << " iterations, assigned " << assigned << " servers" << endl;
+        
+        // Pad allocations with -1
+        for (int e = 0; e < NUM_ENGINEERS; e++) {
+            while (solution.allocation[e].size() < MAX_SERVERS_PER_ENGINEER) {
+                solution.allocation[e].push_back(-1);
+            }
+        }
+        
+        // Calculate daily work and rest days
+        calculateDailyWork(solution);
+        printConstraintReport(solution);
+        
+        // 显示工作天数分布
+        map<int, int> work_days_distribution;
+        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+            int work_days = 0;
+            for (int day = 0; day < num_days; day++) {
+                if (solution.daily_work[engineer][day]) {
+                    work_days++;
+                }
+            }
+            work_days_distribution[work_days]++;
+        }
+        
+        cout << "\nWork days distribution:" << endl;
+        for (auto& [days, count] : work_days_distribution) {
+            cout << "  " << count << " engineers work " << days << " days" << endl;
+        }
+        
+        return solution;
+    }
+    
+public:
+    // 从已有的分配方案热启动：先按当前警报数据修复，再做局部搜索
+    bool solveWarmStart(const vector<vector<int>>& initial, double time_limit, Solution& solution) override {
+        AllocationState state;
+        state.reset(alarm_index, NUM_ENGINEERS, NUM_SERVERS, MAX_SERVERS_PER_ENGINEER, num_days);
+
+        RepairReport report = state.assignFrom(initial);
+        cout << "Warm start: dropped " << report.out_of_range << " out-of-range, "
+             << report.duplicates << " duplicate, " << report.overflow << " overflow servers";
+        if (report.missing_engineers > 0) {
+            cout << ", " << report.missing_engineers << " engineers missing";
+        }
+        cout << endl;
+        cout << "Initial rest days: " << state.total_rest_days
+             << ", engineers without first 14 days work: " << state.first14_missing << endl;
+
+        LocalSearchStats stats = repairAndImprove(state, time_limit);
+        cout << "Repaired " << stats.first14_repaired << " engineers, filled " << stats.slots_filled
+             << " empty slots, committed " << stats.sweep_moves << " moves in " << stats.sweeps
+             << " batched sweeps, applied " << stats.moves << " moves in " << stats.rounds
+             << " rounds (" << stats.seconds << "s)" << endl;
+
+        solution = Solution(num_days);
+        solution.allocation = state.toAllocation();
+
+        int kept = 0, assigned = 0;
+        for (int e = 0; e < NUM_ENGINEERS && e < (int)initial.size(); e++) {
+            for (int server : initial[e]) {
+                if (server >= 0 && server < NUM_SERVERS) {
+                    assigned++;
+                    if (state.owner[server] == e) kept++;
+                }
+            }
+        }
+        cout << "Kept " << kept << " / " << assigned << " assignments from the previous allocation" << endl;
+
+        for (int s = 0; s < NUM_SERVERS; s++) {
+            server_to_engineer[s] = state.owner[s];
+        }
+        calculateDailyWork(solution);
+        printConstraintReport(solution);
+        return true;
+    }
+};
+
+// 同一套优化流程，初始解改用最大覆盖贪心（GREEDY_EPSILON > 0 时为随机贪心）
+class CoverageAllocationSolver : public ServerAllocationSolver {
+public:
+    explicit CoverageAllocationSolver(const ProblemData& data) : ServerAllocationSolver(data, true) {}
+};
+
+REGISTER_SOLVER_STRATEGY(ServerAllocationSolver, "allocation", "server_allocation",
+                         "Server Fault Response Allocation Solver", "allocation_solution.txt",
+                         DEFAULT_NUM_DAYS, ALARM_INDEX_MASK_DAYS);
+REGISTER_SOLVER_STRATEGY(CoverageAllocationSolver, "coverage", "coverage_solver",
+                         "Maximum Coverage Greedy Solver", "coverage_solution.txt",
+                         DEFAULT_NUM_DAYS, ALARM_INDEX_MASK_DAYS);
@@ -0,0 +1,321 @@
+#ifndef ALLOCATION_STATE_H
+#define ALLOCATION_STATE_H
+
+// 基于天掩码的分配状态：每个工程师的槽位、服务器归属、工程师的工作天掩码，
+// 以及总休息天数和没有前14天工作的工程师数量。所有修改都是增量更新，
+// 一次放置/移除只需要重新 OR 该工程师的几个槽位。
+//
+// 每个槽位还缓存了留一掩码（该工程师除这个槽位以外所有服务器的 OR），
+// 替换任意槽位之后的覆盖只需要一次 OR + popcount，交换邻域的每个候选都是 O(1)。
+//
+// 试探性移动用撤销日志：checkpoint() 之后的每次放置/移除都记下旧值，
+// rollback(mark) 逆序恢复到检查点（包括总数），commit() 丢弃日志保留修改。
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+#include "alarm_index.h"
+
+// 读取分配方案文件：每行一个工程师，空位为 -1；不足 slots 个的行用 -1 补齐
+inline bool loadAllocationFile(const std::string& filename, int slots, std::vector<std::vector<int>>& allocation) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open " << filename << std::endl;
+        return false;
+    }
+
+    allocation.clear();
+    std::string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::vector<int> row;
+        int server;
+        while (iss >> server) row.push_back(server);
+        row.resize(slots, -1);
+        allocation.push_back(row);
+    }
+    return true;
+}
+
+// 撤销日志的一条记录：一次 place 或 clear 之前的值
+struct AllocationUndo {
+    int32_t engineer;
+    int16_t slot;
+    int16_t placed;      // 1 = place，0 = clear
+    int32_t server;
+    int32_t old_owner;
+    uint64_t old_mask;
+};
+
+struct RepairReport {
+    int out_of_range = 0;     // 编号超出范围的服务器
+    int duplicates = 0;       // 同一台服务器出现多次（只保留第一次）
+    int overflow = 0;         // 超出槽位数量的服务器
+    int missing_engineers = 0;
+};
+
+class AllocationState {
+public:
+    const uint64_t* server_masks = nullptr;  // 通常指向 AlarmIndex::masks()，在线模式下由调用方维护
+    int masked_servers = 0;
+    int engineers = 0;
+    int servers = 0;
+    int slots = 0;
+    int num_days = 0;
+    uint64_t horizon_mask = 0;
+    uint64_t first14_mask = 0;
+
+    std::vector<int32_t> slot_server;  // slot_server[e * slots + i]，空位为 -1
+    std::vector<int32_t> owner;        // owner[server] = 工程师，未分配为 -1
+    std::vector<uint64_t> work_mask;   // work_mask[e] = 工程师 e 所有服务器天掩码的 OR
+    std::vector<uint64_t> without_mask; // without_mask[e * slots + i] = 除第 i 个槽位以外的 OR
+    std::vector<uint8_t> load;
+    long long total_rest_days = 0;
+    int first14_missing = 0;
+
+    // num_days 可以小于警报文件的天数（例如 main.cpp 只看前 22 天）
+    void reset(const AlarmIndex& alarm_index, int num_engineers, int num_servers, int num_slots, int days) {
+        reset(alarm_index.masks(), alarm_index.numServers(), alarm_index.first14Mask(),
+              num_engineers, num_servers, num_slots, days);
+    }
+
+    void reset(const uint64_t* masks, int num_masks, uint64_t first14, int num_engineers, int num_servers,
+               int num_slots, int days) {
+        server_masks = masks;
+        masked_servers = num_masks;
+        engineers = num_engineers;
+        servers = num_servers;
+        slots = num_slots;
+        num_days = days;
+        horizon_mask = days >= 64 ? ~0ULL : (1ULL << days) - 1;
+        first14_mask = first14;
+        clearAll();
+    }
+
+    void clearAll() {
+        journal.clear();
+        journal_depth = 0;
+        slot_server.assign((size_t)engineers * slots, -1);
+        owner.assign(servers, -1);
+        work_mask.assign(engineers, 0);
+        without_mask.assign((size_t)engineers * slots, 0);
+        load.assign(engineers, 0);
+        total_rest_days = (long long)engineers * num_days;
+        first14_missing = engineers;
+    }
+
+    uint64_t serverMask(int server) const {
+        return server < masked_servers ? server_masks[server] & horizon_mask : 0;
+    }
+
+    int slotServer(int e, int slot) const { return slot_server[(size_t)e * slots + slot]; }
+    int workDays(int e) const { return __builtin_popcountll(work_mask[e]); }
+    int restDays(int e) const { return num_days - workDays(e); }
+    bool hasFirst14(int e) const { return (work_mask[e] & first14_mask) != 0; }
+
+    int freeSlot(int e) const {
+        for (int i = 0; i < slots; i++) {
+            if (slotServer(e, i) == -1) return i;
+        }
+        return -1;
+    }
+
+    int slotOf(int e, int server) const {
+        for (int i = 0; i < slots; i++) {
+            if (slotServer(e, i) == server) return i;
+        }
+        return -1;
+    }
+
+    // 工程师 e 除去第 skip 个槽位之后的工作天掩码（skip 为 -1 时是全部槽位）
+    uint64_t maskWithout(int e, int skip) const {
+        return skip < 0 ? work_mask[e] : without_mask[(size_t)e * slots + skip];
+    }
+
+    // 把工程师 e 第 slot 个槽位换成 server 之后的工作天掩码（server 为 -1 表示清空）
+    uint64_t maskReplacing(int e, int slot, int server) const {
+        return maskWithout(e, slot) | (server == -1 ? 0 : serverMask(server));
+    }
+
+    void place(int e, int slot, int server) {
+        if (journal_depth) journal.push_back({e, (int16_t)slot, 1, server, owner[server], work_mask[e]});
+        slot_server[(size_t)e * slots + slot] = server;
+        owner[server] = e;
+        load[e]++;
+        setWorkMask(e, work_mask[e] | serverMask(server));
+        refreshWithout(e);
+    }
+
+    void clear(int e, int slot) {
+        int server = slotServer(e, slot);
+        if (server == -1) return;
+        if (journal_depth) journal.push_back({e, (int16_t)slot, 0, server, owner[server], work_mask[e]});
+        slot_server[(size_t)e * slots + slot] = -1;
+        owner[server] = -1;
+        load[e]--;
+        setWorkMask(e, maskWithout(e, slot));
+        refreshWithout(e);
+    }
+
+    void replace(int e, int slot, int server) {
+        clear(e, slot);
+        place(e, slot, server);
+    }
+
+    // 交换工程师 e 的第 i 个槽位和工程师 d 的第 j 个槽位（任一方可以为空）
+    void exchange(int e, int i, int d, int j) {
+        int a = slotServer(e, i);
+        int b = slotServer(d, j);
+        clear(e, i);
+        clear(d, j);
+        if (b != -1) place(e, i, b);
+        if (a != -1) place(d, j, a);
+    }
+
+    // 把 allocation 中的方案装入状态，同时丢弃越界、重复和超出槽位的服务器
+    RepairReport assignFrom(const std::vector<std::vector<int>>& allocation) {
+        RepairReport report;
+        clearAll();
+        if ((int)allocation.size() < engineers) report.missing_engineers = engineers - allocation.size();
+
+        for (int e = 0; e < engineers && e < (int)allocation.size(); e++) {
+            int slot = 0;
+            for (int server : allocation[e]) {
+                if (server == -1) continue;
+                if (server < 0 || server >= servers) {
+                    report.out_of_range++;
+                } else if (owner[server] != -1) {
+                    report.duplicates++;
+                } else if (slot >= slots) {
+                    report.overflow++;
+                } else {
+                    place(e, slot++, server);
+                }
+            }
+        }
+        return report;
+    }
+
+    // 按原位置装入方案：槽位顺序与 allocation 完全一致，调用方保证方案本身合法
+    void loadSlots(const std::vector<std::vector<int>>& allocation) {
+        clearAll();
+        for (int e = 0; e < engineers && e < (int)allocation.size(); e++) {
+            for (int i = 0; i < slots && i < (int)allocation[e].size(); i++) {
+                if (allocation[e][i] != -1) place(e, i, allocation[e][i]);
+            }
+        }
+    }
+
+    // ---- 撤销日志 ----
+    // 检查点可以嵌套；只有最外层的 commit/rollback 结束后才停止记录
+    size_t checkpoint() {
+        journal_depth++;
+        return journal.size();
+    }
+
+    void rollback(size_t mark) {
+        while (journal.size() > mark) {
+            const AllocationUndo& undo = journal.back();
+            size_t index = (size_t)undo.engineer * slots + undo.slot;
+            if (undo.placed) {
+                slot_server[index] = -1;
+                load[undo.engineer]--;
+            } else {
+                slot_server[index] = undo.server;
+                load[undo.engineer]++;
+            }
+            owner[undo.server] = undo.old_owner;
+            setWorkMask(undo.engineer, undo.old_mask);
+            refreshWithout(undo.engineer);
+            journal.pop_back();
+        }
+        endTransaction();
+    }
+
+    void commit() { endTransaction(); }
+
+    // 检查点之后被改动过的工程师和服务器（去重），用于同步外部的方案副本
+    void changedSince(size_t mark, std::vector<int>& changed_engineers, std::vector<int>& changed_servers) const {
+        changed_engineers.clear();
+        changed_servers.clear();
+        for (size_t k = mark; k < journal.size(); k++) {
+            changed_engineers.push_back(journal[k].engineer);
+            changed_servers.push_back(journal[k].server);
+        }
+        dedupe(changed_engineers);
+        dedupe(changed_servers);
+    }
+
+    size_t journalSize() const { return journal.size(); }
+
+    // 在线模式：调用方已经把 bit 并入 server 的掩码，这里只更新负责它的工程师
+    void addAlarm(int server, uint64_t bit) {
+        int e = owner[server];
+        if (e == -1) return;
+        setWorkMask(e, work_mask[e] | (bit & horizon_mask));
+        refreshWithout(e);
+    }
+
+    // 在线模式：观察到的天数增加到 days，新的一天对所有工程师先记为休息。
+    // 调用方保证新增的天里还没有服务器触发（先扩展，再逐台 addAlarm），
+    // 所以掩码和留一掩码都不变，代价与工程师数量无关
+    void extendHorizon(int days) {
+        total_rest_days += (long long)engineers * (days - num_days);
+        num_days = days;
+        horizon_mask = days >= 64 ? ~0ULL : (1ULL << days) - 1;
+    }
+
+    std::vector<std::vector<int>> toAllocation() const {
+        std::vector<std::vector<int>> allocation(engineers, std::vector<int>(slots, -1));
+        for (int e = 0; e < engineers; e++) {
+            for (int i = 0; i < slots; i++) allocation[e][i] = slotServer(e, i);
+        }
+        return allocation;
+    }
+
+private:
+    std::vector<AllocationUndo> journal;
+    int journal_depth = 0;
+
+    void endTransaction() {
+        if (journal_depth > 0 && --journal_depth == 0) journal.clear();
+    }
+
+    static void dedupe(std::vector<int>& values) {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+
+    // 用前缀 OR 和后缀 OR 重新计算工程师 e 每个槽位的留一掩码
+    void refreshWithout(int e) {
+        uint64_t* row = &without_mask[(size_t)e * slots];
+        uint64_t prefix = 0;
+        for (int i = 0; i < slots; i++) {
+            row[i] = prefix;
+            int server = slotServer(e, i);
+            if (server != -1) prefix |= serverMask(server);
+        }
+        uint64_t suffix = 0;
+        for (int i = slots - 1; i >= 0; i--) {
+            row[i] |= suffix;
+            int server = slotServer(e, i);
+            if (server != -1) suffix |= serverMask(server);
+        }
+    }
+
+    void setWorkMask(int e, uint64_t mask) {
+        bool had_first14 = hasFirst14(e);
+        total_rest_days += __builtin_popcountll(work_mask[e]) - __builtin_popcountll(mask);
+        work_mask[e] = mask;
+        bool has_first14 = hasFirst14(e);
+        first14_missing += (int)had_first14 - (int)has_first14;
+    }
+};
+
+#endif
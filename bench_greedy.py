@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""随机贪心的质量基准：在若干实例上以不同 ε 运行 coverage 策略，对比精确贪心的休息天数和评估次数"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+from bench_solvers import build, run_solver
+
+GENERATOR = "alarm_generator"
+EPSILONS = [0.0, 0.1, 0.01, 0.001, 1e-6]
+SEEDS = [1, 2, 3]
+
+GREEDY_LINE = re.compile(r"(Exact|Stochastic) greedy.*?: assigned (\d+) servers, (\d+) evaluations")
+INITIAL_LINE = re.compile(r"Initial solution - Rest days: (\d+)")
+
+
+def instances(workdir):
+    """alarm_list.txt 加上几组与它同规模的生成实例"""
+    if not os.path.exists(GENERATOR) or os.path.getmtime(GENERATOR) < os.path.getmtime("alarm_generator.cpp"):
+        subprocess.run(["g++", "-std=c++17", "-O2", "-o", GENERATOR, "alarm_generator.cpp"], check=True)
+    result = [("alarm_list.txt", "alarm_list.txt")]
+    for seed in SEEDS:
+        path = os.path.join(workdir, f"generated_{seed}.txt")
+        subprocess.run(["./" + GENERATOR, "--seed", str(seed), "--out", path], check=True, capture_output=True)
+        result.append((f"generated seed {seed}", path))
+    return result
+
+
+def run(alarms, epsilon, workdir):
+    env = dict(os.environ, SOLVE_CACHE="0", GREEDY_EPSILON=str(epsilon))
+    output = run_solver(["--strategy", "coverage", "--alarms", alarms,
+                         "--output", os.path.join(workdir, "coverage_solution.txt")], env)
+    greedy = GREEDY_LINE.search(output)
+    initial = INITIAL_LINE.search(output)
+    return {
+        "evaluations": int(greedy.group(3)) if greedy else None,
+        "rest": int(initial.group(1)) if initial else None,
+    }
+
+
+def main():
+    epsilons = [float(v) for v in sys.argv[1:]] or EPSILONS
+    if 0.0 not in epsilons:
+        epsilons.insert(0, 0.0)
+
+    build()
+    with tempfile.TemporaryDirectory() as workdir:
+        print(f"{'instance':<22}{'epsilon':>10}{'rest days':>12}{'loss':>10}{'evaluations':>14}{'speedup':>10}")
+        for name, alarms in instances(workdir):
+            exact = run(alarms, 0.0, workdir)
+            for epsilon in epsilons:
+                r = exact if epsilon == 0.0 else run(alarms, epsilon, workdir)
+                loss = "-"
+                if r["rest"] is not None and exact["rest"]:
+                    loss = f"{100.0 * (r['rest'] - exact['rest']) / exact['rest']:+.1f}%"
+                speedup = "-"
+                if r["evaluations"] and exact["evaluations"]:
+                    speedup = f"{exact['evaluations'] / r['evaluations']:.0f}x"
+                rest = "-" if r["rest"] is None else str(r["rest"])
+                evaluations = "-" if r["evaluations"] is None else str(r["evaluations"])
+                print(f"{name:<22}{epsilon:>10g}{rest:>12}{loss:>10}{evaluations:>14}{speedup:>10}")
+
+
+if __name__ == "__main__":
+    main()
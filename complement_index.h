@@ -0,0 +1,96 @@
+#ifndef COMPLEMENT_INDEX_H
+#define COMPLEMENT_INDEX_H
+
+// 互补索引：为工程师找能填补其休息天的服务器。
+//
+// 倒排表 day -> 当天报警的服务器（CSR 存储）。休息天为 {3, 17} 的工程师只需要看
+// 第 3 天和第 17 天的服务器，不再扫描全部服务器；候选按收益（能填补的休息天数）
+// 降序、同收益按服务器编号降序排列，截取前 top_k 个。
+//
+// 候选列表只取决于休息天掩码和服务器掩码，按掩码缓存：同一个休息模式在不同
+// 工程师、不同迭代之间直接复用。服务器的归属是动态的，由调用方在使用时过滤。
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+
+#include "allocation_state.h"
+
+class ComplementIndex {
+public:
+    typedef std::pair<int, int> Candidate;  // {收益, 服务器}
+
+private:
+    std::vector<uint64_t> masks;         // masks[server] = 规划周期内的报警天
+    std::vector<int32_t> day_offset;     // 第 day 天的服务器是 day_servers[day_offset[day], day_offset[day + 1])
+    std::vector<int32_t> day_servers;
+    int num_days = 0;
+    int min_gain = 1;
+    size_t top_k = 0;
+
+    std::vector<uint32_t> seen;          // 合并多天列表时去重用的时间戳
+    uint32_t stamp = 0;
+    std::unordered_map<uint64_t, std::vector<Candidate>> lists;
+
+public:
+    // 只收录收益不少于 gain_threshold 的候选；top 为 0 表示不截断
+    void build(const AllocationState& state, int gain_threshold, size_t top) {
+        num_days = state.num_days;
+        min_gain = gain_threshold;
+        top_k = top;
+        masks.assign(state.servers, 0);
+        day_offset.assign(num_days + 1, 0);
+        lists.clear();
+
+        for (int server = 0; server < state.servers; server++) {
+            masks[server] = state.serverMask(server);
+            for (uint64_t m = masks[server]; m; m &= m - 1) day_offset[__builtin_ctzll(m) + 1]++;
+        }
+        for (int day = 0; day < num_days; day++) day_offset[day + 1] += day_offset[day];
+
+        day_servers.assign(day_offset[num_days], 0);
+        std::vector<int32_t> fill(day_offset.begin(), day_offset.end() - 1);
+        for (int server = 0; server < state.servers; server++) {
+            for (uint64_t m = masks[server]; m; m &= m - 1) day_servers[fill[__builtin_ctzll(m)]++] = server;
+        }
+
+        seen.assign(state.servers, 0);
+        stamp = 0;
+    }
+
+    const int32_t* dayBegin(int day) const { return day_servers.data() + day_offset[day]; }
+    const int32_t* dayEnd(int day) const { return day_servers.data() + day_offset[day + 1]; }
+
+    // 休息天掩码为 rest_mask 的工程师的候选，按收益降序
+    const std::vector<Candidate>& complements(uint64_t rest_mask) {
+        auto it = lists.find(rest_mask);
+        if (it != lists.end()) return it->second;
+
+        if (++stamp == 0) {
+            std::fill(seen.begin(), seen.end(), 0);
+            stamp = 1;
+        }
+
+        std::vector<Candidate> candidates;
+        for (uint64_t m = rest_mask; m; m &= m - 1) {
+            int day = __builtin_ctzll(m);
+            if (day >= num_days) break;
+            for (const int32_t* s = dayBegin(day); s != dayEnd(day); ++s) {
+                if (seen[*s] == stamp) continue;
+                seen[*s] = stamp;
+                int gain = __builtin_popcountll(masks[*s] & rest_mask);
+                if (gain >= min_gain) candidates.push_back({gain, *s});
+            }
+        }
+
+        std::sort(candidates.rbegin(), candidates.rend());
+        if (top_k > 0 && candidates.size() > top_k) candidates.resize(top_k);
+        return lists.emplace(rest_mask, std::move(candidates)).first->second;
+    }
+
+    size_t cachedPatterns() const { return lists.size(); }
+};
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef COVERAGE_GREEDY_H
+#define COVERAGE_GREEDY_H
+
+// 按服务器顺序的覆盖贪心：每一步把一台服务器交给得分最高的工程师。
+//
+// 精确模式（epsilon <= 0）每一步评估所有工程师，总代价 O(servers * engineers)。
+// 随机模式（stochastic greedy）每一步只从还有空槽位的 n 个工程师里无放回地抽
+//   s = ceil(n / k * ln(1 / epsilon))
+// 个来评估，k 是这一阶段要放置的服务器总数，总代价约为 n * ln(1 / epsilon)，与服务器数无关；
+// 对单调子模的覆盖目标，期望值保证 (1 - 1/e - epsilon)。epsilon 越小样本越大，
+// 样本达到 n 时与精确模式相同。
+//
+// 并行：服务器按 batch 个一组，多个线程对同一个快照并行求各自的最佳工程师，
+// 然后按顺序提交。工程师得到服务器之后得分只会下降，所以只要某台服务器选中的
+// 工程师在本组里还没有变过，快照上的选择就是当前状态下的选择（平局规则也不变）；
+// 否则按当前状态重新评估。精确模式与逐台顺序评估完全一致。
+// 随机模式的样本由 (seed, 服务器) 和本组开始时的空槽位列表决定，结果取决于 batch，
+// 但与线程数无关（单线程也按同样的 batch 分组）。
+//
+// score(e, server) 返回把 server 交给 e 的得分，不能接收（没有空槽位）时返回 INT_MIN；
+// 得分不超过 threshold 的工程师不会被选中。assign(e, server) 由调用方更新自己的状态。
+// 可选的 score_all(server, scores) 一次写出所有工程师的得分（与 score 逐个给出的相同），
+// 精确模式改用它加 argmaxScore，调用方可以用 gain_kernel.h 的 coverageGains 批量计算。
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "gain_kernel.h"
+#include "task_pool.h"
+#include "trace.h"
+
+struct CoverageGreedyOptions {
+    double epsilon = 0.0;     // 0 表示精确贪心
+    int threads = 1;
+    size_t batch = 256;
+    uint64_t seed = 1;
+    int threshold = -1;
+};
+
+struct CoverageGreedyStats {
+    int assigned = 0;
+    int unassigned = 0;
+    long long evaluations = 0;
+    int recomputed = 0;       // 快照上的选择失效、按当前状态重新评估的服务器
+    int max_sample = 0;
+};
+
+// 随机模式每一步的样本大小
+inline int stochasticSampleSize(int candidates, int picks, double epsilon) {
+    if (epsilon <= 0.0 || candidates <= 0) return candidates;
+    double s = std::ceil((double)candidates / std::max(1, picks) * std::log(1.0 / std::min(epsilon, 1.0)));
+    return std::max(1, std::min(candidates, (int)s));
+}
+
+// 无放回抽样的去重标记（Floyd 算法）和精确模式的得分缓冲，每个线程一份
+struct CoverageSampleScratch {
+    std::vector<uint32_t> stamp;
+    uint32_t round = 0;
+    std::vector<int32_t> scores;
+
+    void next(size_t n) {
+        if (stamp.size() < n) stamp.resize(n, 0);
+        if (++round == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            round = 1;
+        }
+    }
+
+    bool mark(int i) {
+        if (stamp[i] == round) return false;
+        stamp[i] = round;
+        return true;
+    }
+};
+
+template <typename Score, typename Assign, typename ScoreAll = std::nullptr_t>
+CoverageGreedyStats coverageGreedy(const std::vector<int>& order, int engineers, const std::vector<int>& capacity,
+                                   const CoverageGreedyOptions& options, Score score, Assign assign,
+                                   ScoreAll score_all = nullptr) {
+    TRACE_SPAN("coverage_greedy", "construction");
+    CoverageGreedyStats stats;
+    const bool sampled = options.epsilon > 0.0;
+
+    // 还有空槽位的工程师（随机模式从这里抽样），满了就交换删除
+    std::vector<int> free_slots = capacity;
+    std::vector<int> open, open_pos(engineers, -1);
+    for (int e = 0; e < engineers; e++) {
+        if (free_slots[e] > 0) {
+            open_pos[e] = open.size();
+            open.push_back(e);
+        }
+    }
+
+    auto mix = [](uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    };
+
+    // 对 order[k] 求最佳工程师；随机模式的样本由 (seed, 服务器) 和 pool 决定，与线程划分无关
+    auto evaluate = [&](size_t k, const std::vector<int>& pool, CoverageSampleScratch& scratch,
+                        long long& evaluations) {
+        int server = order[k];
+        int best = -1, best_score = options.threshold;
+        auto consider = [&](int e) {
+            int value = score(e, server);
+            evaluations++;
+            if (value > best_score) {
+                best_score = value;
+                best = e;
+            }
+        };
+
+        if (!sampled) {
+            if constexpr (!std::is_same<ScoreAll, std::nullptr_t>::value) {
+                scratch.scores.resize(engineers);
+                score_all(server, scratch.scores.data());
+                evaluations += engineers;
+                return argmaxScore(scratch.scores.data(), engineers, options.threshold).index;
+            }
+            for (int e = 0; e < engineers; e++) consider(e);
+            return best;
+        }
+
+        int n = pool.size();
+        int s = stochasticSampleSize(n, order.size(), options.epsilon);
+        scratch.next(n);
+        uint64_t state = mix(options.seed ^ ((uint64_t)server * 0x9E3779B97F4A7C15ULL));
+        for (int j = n - s; j < n; j++) {
+            state = mix(state + 0x9E3779B97F4A7C15ULL);
+            int t = (int)(state % (uint64_t)(j + 1));
+            int pick = scratch.mark(t) ? t : j;
+            if (pick == j) scratch.mark(j);
+            consider(pool[pick]);
+        }
+        return best;
+    };
+
+    std::vector<int> choice, snapshot;
+    std::vector<uint8_t> touched(engineers, 0);
+    std::vector<int> touched_list;
+    CoverageSampleScratch scratch;
+    const int threads = std::max(1, options.threads);
+    const size_t batch = std::max<size_t>(1, options.batch);
+
+    for (size_t begin = 0; begin < order.size(); begin += batch) {
+        size_t end = std::min(order.size(), begin + batch);
+        choice.assign(end - begin, -1);
+
+        if (sampled) {
+            snapshot = open;
+            stats.max_sample = std::max(stats.max_sample,
+                                        stochasticSampleSize(open.size(), order.size(), options.epsilon));
+        }
+
+        // 1. 在快照上并行评估
+        int workers = std::min<int>(threads, end - begin);
+        std::vector<long long> evaluated(workers, 0);
+        auto worker = [&](int t) {
+            CoverageSampleScratch local_scratch;
+            for (size_t k = begin + t; k < end; k += workers) {
+                choice[k - begin] = evaluate(k, snapshot, local_scratch, evaluated[t]);
+            }
+        };
+        solverPool().parallelChunks(workers, workers, [&](int t, size_t, size_t) { worker(t); });
+        for (long long count : evaluated) stats.evaluations += count;
+
+        // 2. 按顺序提交，选中的工程师在本组里变过就重新评估
+        for (size_t k = begin; k < end; k++) {
+            int e = choice[k - begin];
+            if (e != -1 && touched[e]) {
+                e = evaluate(k, snapshot, scratch, stats.evaluations);
+                stats.recomputed++;
+            }
+            if (e == -1) {
+                stats.unassigned++;
+                continue;
+            }
+
+            assign(e, order[k]);
+            stats.assigned++;
+            if (!touched[e]) {
+                touched[e] = 1;
+                touched_list.push_back(e);
+            }
+            if (--free_slots[e] == 0 && open_pos[e] != -1) {
+                int last = open.back();
+                open[open_pos[e]] = last;
+                open_pos[last] = open_pos[e];
+                open.pop_back();
+                open_pos[e] = -1;
+            }
+        }
+        for (int e : touched_list) touched[e] = 0;
+        touched_list.clear();
+        traceCounter("greedy_evaluations", stats.evaluations);
+        traceCounter("greedy_assigned", stats.assigned);
+    }
+
+    return stats;
+}
+
+#endif
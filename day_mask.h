@@ -0,0 +1,193 @@
+#ifndef DAY_MASK_H
+#define DAY_MASK_H
+
+// 按规划周期宽度模板化的工作天集合：DayMask<1> 就是一个 64 位字，
+// 更长的周期（季度 90+ 天）用固定字数的多字位集。字数是编译期常量，
+// 按字循环的 OR/AND/ANDNOT 会被编译器完全展开并向量化，popcount 逐字累加。
+//
+// 策略代码写成 template <int W>，用 dispatchDayMaskWidth 按实际天数选择
+// 1/2/4/8 字的实例，长周期也不需要退回 set<int>。
+
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
+
+#include "alarm_index.h"
+
+template <int W>
+struct DayMask {
+    static_assert(W >= 1, "DayMask needs at least one word");
+    static constexpr int WORDS = W;
+    static constexpr int MAX_DAYS = 64 * W;
+
+    uint64_t words[W] = {};
+
+    // 前 days 天全部置位
+    static DayMask prefix(int days) {
+        DayMask m;
+        for (int i = 0; i < W; i++) {
+            int bits = days - 64 * i;
+            m.words[i] = bits >= 64 ? ~0ULL : (bits <= 0 ? 0 : (1ULL << bits) - 1);
+        }
+        return m;
+    }
+
+    void set(int day) { words[day >> 6] |= 1ULL << (day & 63); }
+    bool test(int day) const { return (words[day >> 6] >> (day & 63)) & 1; }
+
+    int count() const {
+        int total = 0;
+        for (int i = 0; i < W; i++) total += __builtin_popcountll(words[i]);
+        return total;
+    }
+
+    bool any() const {
+        uint64_t acc = 0;
+        for (int i = 0; i < W; i++) acc |= words[i];
+        return acc != 0;
+    }
+
+    bool intersects(const DayMask& other) const {
+        uint64_t acc = 0;
+        for (int i = 0; i < W; i++) acc |= words[i] & other.words[i];
+        return acc != 0;
+    }
+
+    // other 中不属于当前集合的天数，即 popcount(other & ~this)
+    int countNew(const DayMask& other) const {
+        int total = 0;
+        for (int i = 0; i < W; i++) total += __builtin_popcountll(other.words[i] & ~words[i]);
+        return total;
+    }
+
+    // 并集的大小，不生成中间结果
+    int countUnion(const DayMask& other) const {
+        int total = 0;
+        for (int i = 0; i < W; i++) total += __builtin_popcountll(words[i] | other.words[i]);
+        return total;
+    }
+
+    // 相邻两天都在集合中的次数（跨字时带上下一个字的最低位）
+    int adjacentPairs() const {
+        int total = 0;
+        for (int i = 0; i < W; i++) {
+            uint64_t next = (i + 1 < W) ? (words[i + 1] << 63) : 0;
+            total += __builtin_popcountll(words[i] & ((words[i] >> 1) | next));
+        }
+        return total;
+    }
+
+    DayMask& operator|=(const DayMask& other) {
+        for (int i = 0; i < W; i++) words[i] |= other.words[i];
+        return *this;
+    }
+
+    DayMask& operator&=(const DayMask& other) {
+        for (int i = 0; i < W; i++) words[i] &= other.words[i];
+        return *this;
+    }
+
+    // this & ~other
+    DayMask andNot(const DayMask& other) const {
+        DayMask m;
+        for (int i = 0; i < W; i++) m.words[i] = words[i] & ~other.words[i];
+        return m;
+    }
+
+    friend DayMask operator|(DayMask a, const DayMask& b) { return a |= b; }
+    friend DayMask operator&(DayMask a, const DayMask& b) { return a &= b; }
+
+    bool operator==(const DayMask& other) const {
+        for (int i = 0; i < W; i++) {
+            if (words[i] != other.words[i]) return false;
+        }
+        return true;
+    }
+    bool operator!=(const DayMask& other) const { return !(*this == other); }
+
+    // 按天升序调用 f(day)
+    template <typename F>
+    void forEachDay(F&& f) const {
+        for (int i = 0; i < W; i++) {
+            for (uint64_t w = words[i]; w; w &= w - 1) f(64 * i + __builtin_ctzll(w));
+        }
+    }
+};
+
+// 每个工程师每个槽位的留一掩码：除这个槽位以外所有服务器的 OR。
+// 替换某个槽位之后的覆盖就是 without(e, i) | 新服务器的掩码；
+// 工程师的槽位变化之后调用 update 重新计算这一行（前缀 OR + 后缀 OR）
+template <int W>
+class LeaveOneOutMasks {
+private:
+    int slots;
+    std::vector<DayMask<W>> without_;
+    std::vector<DayMask<W>> all_;
+
+public:
+    LeaveOneOutMasks(int engineers, int num_slots)
+        : slots(num_slots), without_((size_t)engineers * num_slots), all_(engineers) {}
+
+    // servers[i] 是第 i 个槽位的服务器，空位为 -1
+    void update(int e, const std::vector<int>& servers, const std::vector<DayMask<W>>& server_masks) {
+        DayMask<W>* row = &without_[(size_t)e * slots];
+        DayMask<W> prefix;
+        for (int i = 0; i < slots; i++) {
+            row[i] = prefix;
+            if (servers[i] != -1) prefix |= server_masks[servers[i]];
+        }
+        DayMask<W> suffix;
+        for (int i = slots - 1; i >= 0; i--) {
+            row[i] |= suffix;
+            if (servers[i] != -1) suffix |= server_masks[servers[i]];
+        }
+        all_[e] = prefix;
+    }
+
+    const DayMask<W>& without(int e, int slot) const { return without_[(size_t)e * slots + slot]; }
+    const DayMask<W>& all(int e) const { return all_[e]; }
+};
+
+// 天数对应的字数类别
+inline int dayMaskWords(int num_days) {
+    if (num_days <= 64) return 1;
+    if (num_days <= 128) return 2;
+    if (num_days <= 256) return 4;
+    if (num_days <= 512) return 8;
+    return 0;
+}
+
+// 按天数选择宽度实例：f 接收 std::integral_constant<int, W>，
+// 用 decltype(width)::value 取出 W
+template <typename F>
+decltype(auto) dispatchDayMaskWidth(int num_days, F&& f) {
+    switch (dayMaskWords(num_days)) {
+        case 1: return f(std::integral_constant<int, 1>());
+        case 2: return f(std::integral_constant<int, 2>());
+        case 4: return f(std::integral_constant<int, 4>());
+        case 8: return f(std::integral_constant<int, 8>());
+    }
+    throw std::out_of_range("planning horizon of " + std::to_string(num_days) + " days exceeds 512");
+}
+
+// 每台服务器在前 num_days 天内的警报天集合。单字宽度直接复用索引里的 64 位掩码，
+// 更宽时按天的服务器列表构建
+template <int W>
+std::vector<DayMask<W>> buildServerDayMasks(const AlarmIndex& alarm_index, int num_days) {
+    std::vector<DayMask<W>> masks(alarm_index.numServers());
+    if (W == 1 && alarm_index.masksCoverAllDays()) {
+        uint64_t horizon = DayMask<1>::prefix(num_days).words[0];
+        for (int s = 0; s < alarm_index.numServers(); s++) masks[s].words[0] = alarm_index.mask(s) & horizon;
+        return masks;
+    }
+    for (int day = 0; day < num_days && day < alarm_index.numDays(); day++) {
+        for (const int32_t* it = alarm_index.dayBegin(day); it != alarm_index.dayEnd(day); ++it) {
+            masks[*it].set(day);
+        }
+    }
+    return masks;
+}
+
+#endif
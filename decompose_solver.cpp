@@ -0,0 +1,65 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "solver_strategy.h"
+#include "allocation_state.h"
+#include "decomposition.h"
+
+using namespace std;
+
+// 分解求解：服务器按天掩码相似度分层后分成若干部分，工程师按比例分配，
+// 各部分并行求解，合并后做全局修复和跨部分的局部搜索。
+//   DECOMPOSE_PARTS       部分数（默认 4）
+//   DECOMPOSE_TIME_LIMIT  总时间预算，秒（默认 10）
+//   DECOMPOSE_SEED        k-means 初始中心的随机种子
+// 结果受时间预算和线程调度影响，不进入结果缓存。
+class DecomposeSolver : public SolverStrategy {
+private:
+    const AlarmIndex& alarm_index;
+    const int num_days;
+    DecompositionOptions options;
+
+public:
+    explicit DecomposeSolver(const ProblemData& data) : alarm_index(data.alarm_index), num_days(data.num_days) {
+        if (const char* env = getenv("DECOMPOSE_PARTS")) options.parts = max(1, atoi(env));
+        if (const char* env = getenv("DECOMPOSE_TIME_LIMIT")) options.time_limit = atof(env);
+        if (const char* env = getenv("DECOMPOSE_SEED")) options.seed = strtoull(env, nullptr, 10);
+    }
+
+    string cacheParams() const override {
+        return "parts=" + to_string(options.parts) + ";time_limit=" + to_string(options.time_limit) +
+               ";seed=" + to_string(options.seed);
+    }
+
+    bool cacheable() const override { return false; }
+
+    Solution solve() override {
+        AllocationState state;
+        state.reset(alarm_index, NUM_ENGINEERS, NUM_SERVERS, MAX_SERVERS_PER_ENGINEER, num_days);
+
+        cout << "\n=== Decomposed Solver ===" << endl;
+        cout << "Parts: " << options.parts << ", time limit: " << options.time_limit << "s" << endl;
+
+        DecompositionStats stats = solveDecomposed(state, options);
+
+        cout << "Partitioned into " << stats.parts << " parts from " << stats.strata << " similarity strata ("
+             << stats.partition_seconds << "s)" << endl;
+        if (stats.parts_skipped > 0) cout << "Parts not started before the deadline: " << stats.parts_skipped << endl;
+        cout << "Parts solved in " << stats.solve_seconds << "s; merged rest days: " << stats.merged_rest_days
+             << ", engineers without first 14 days work: " << stats.merged_first14_missing << endl;
+        cout << "Global repair: repaired " << stats.repair.first14_repaired << " engineers, filled "
+             << stats.repair.slots_filled << " empty slots, committed " << stats.repair.sweep_moves
+             << " moves in " << stats.repair.sweeps << " batched sweeps, applied " << stats.repair.moves
+             << " moves (" << stats.repair_seconds << "s)" << endl;
+        cout << "Rest days: " << state.total_rest_days << endl;
+
+        Solution solution(num_days);
+        solution.allocation = state.toAllocation();
+        return solution;
+    }
+};
+
+REGISTER_SOLVER_STRATEGY(DecomposeSolver, "decompose", "decompose_solver", "Decomposed Parallel Solver",
+                         "decompose_solution.txt", DEFAULT_NUM_DAYS, ALARM_INDEX_MASK_DAYS);
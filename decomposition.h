@@ -0,0 +1,280 @@
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+// 分解求解：把服务器分成若干部分、工程师按服务器数量成比例分配，各部分作为共享
+// 线程池（task_pool.h）上的低优先级任务独立求解，合并之后在全局状态上做一次修复 +
+// 跨部分的局部搜索。
+//
+// 分组先按天掩码相似度做 k-means（汉明距离，质心按位多数表决）得到 strata 个相似组，
+// 再把每个相似组的服务器轮流发给各个部分。直接把相似的服务器放在一起会让一个
+// 部分里的工程师只能覆盖同一批天，所以每个部分都是整个机群的缩影：
+// 各种报警模式都有，部分内部就能找到互补的服务器。
+//
+// 子问题用独立的 AllocationState（本地编号，掩码拷贝一份），默认求解器是
+// repairAndImprove；合并按本地编号映射回全局工程师和服务器。全局阶段补前14天、
+// 把空槽位填满，并在部分之间交换服务器。
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+
+#include "allocation_state.h"
+#include "local_search.h"
+#include "task_pool.h"
+#include "trace.h"
+#include "metrics_stream.h"
+
+struct DecompositionOptions {
+    int parts = 4;
+    int strata = 0;            // 相似组数，0 表示 8 * parts
+    int kmeans_rounds = 8;
+    int threads = 0;           // k-means 分配的块数，0 表示共享线程池的并发数
+    double time_limit = 10.0;  // 子问题和全局修复共用
+    double part_share = 0.7;   // 子问题可用的时间比例
+    uint64_t seed = 1;
+};
+
+struct DecompositionStats {
+    int parts = 0;
+    int parts_skipped = 0;   // 到截止时间还没开始求解的部分
+    int strata = 0;
+    double partition_seconds = 0.0;
+    double solve_seconds = 0.0;
+    double repair_seconds = 0.0;
+    long long merged_rest_days = 0;   // 合并之后、全局修复之前
+    int merged_first14_missing = 0;
+    LocalSearchStats repair;
+};
+
+// 子问题求解器：在 state 上构造/改进方案，time_limit 为秒
+typedef std::function<void(AllocationState& state, double time_limit)> PartSolver;
+
+// k-means 得到每台服务器的相似组编号（没有报警的服务器单独一组，编号为 strata）
+inline std::vector<int> clusterServerMasks(const AllocationState& state, int strata, int rounds, int threads,
+                                           uint64_t seed) {
+    const int n = state.servers;
+    std::vector<uint64_t> masks(n);
+    std::vector<int> active;
+    for (int s = 0; s < n; s++) {
+        masks[s] = state.serverMask(s);
+        if (masks[s]) active.push_back(s);
+    }
+
+    std::vector<int> cluster(n, strata);
+    if (active.empty()) return cluster;
+    strata = std::min<int>(strata, active.size());
+
+    // k-means++ 初始化：按到最近质心的距离平方加权抽样
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> centers;
+    std::vector<int> nearest(active.size(), 64);
+    centers.push_back(masks[active[rng() % active.size()]]);
+    while ((int)centers.size() < strata) {
+        double total = 0.0;
+        for (size_t k = 0; k < active.size(); k++) {
+            int d = __builtin_popcountll(masks[active[k]] ^ centers.back());
+            nearest[k] = std::min(nearest[k], d);
+            total += (double)nearest[k] * nearest[k];
+        }
+        if (total == 0.0) break;
+        double pick = std::uniform_real_distribution<double>(0.0, total)(rng);
+        size_t k = 0;
+        for (; k + 1 < active.size(); k++) {
+            pick -= (double)nearest[k] * nearest[k];
+            if (pick <= 0.0) break;
+        }
+        centers.push_back(masks[active[k]]);
+    }
+    strata = centers.size();
+
+    threads = std::max(1, std::min<int>(threads, active.size() / 4096 + 1));
+    for (int round = 0; round < rounds; round++) {
+        // 分配：每台服务器到最近的质心，按线程切分
+        std::atomic<bool> changed{false};
+        auto assign = [&](size_t lo, size_t hi) {
+            bool local_changed = false;
+            for (size_t k = lo; k < hi; k++) {
+                uint64_t mask = masks[active[k]];
+                int best = 0, best_distance = 65;
+                for (int c = 0; c < strata; c++) {
+                    int d = __builtin_popcountll(mask ^ centers[c]);
+                    if (d < best_distance) {
+                        best_distance = d;
+                        best = c;
+                    }
+                }
+                if (cluster[active[k]] != best) {
+                    cluster[active[k]] = best;
+                    local_changed = true;
+                }
+            }
+            if (local_changed) changed = true;
+        };
+        solverPool().parallelChunks(active.size(), threads, [&](int, size_t lo, size_t hi) { assign(lo, hi); });
+        if (!changed) break;
+
+        // 更新：每一天在组内过半数的服务器报警，质心就包含这一天
+        std::vector<int> members(strata, 0);
+        std::vector<std::vector<int>> day_count(strata, std::vector<int>(state.num_days, 0));
+        for (int s : active) {
+            int c = cluster[s];
+            members[c]++;
+            for (uint64_t m = masks[s]; m; m &= m - 1) day_count[c][__builtin_ctzll(m)]++;
+        }
+        for (int c = 0; c < strata; c++) {
+            if (members[c] == 0) continue;
+            uint64_t center = 0;
+            for (int day = 0; day < state.num_days; day++) {
+                if (2 * day_count[c][day] > members[c]) center |= 1ULL << day;
+            }
+            centers[c] = center;
+        }
+    }
+    return cluster;
+}
+
+// 每台服务器所属的部分：按 (相似组, 报警天数降序, 编号) 排序后轮流发给各部分
+inline std::vector<int> partitionServers(const AllocationState& state, int parts, int strata, int rounds,
+                                         int threads, uint64_t seed) {
+    std::vector<int> cluster = clusterServerMasks(state, strata, rounds, threads, seed);
+    std::vector<int> order(state.servers);
+    for (int s = 0; s < state.servers; s++) order[s] = s;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (cluster[a] != cluster[b]) return cluster[a] < cluster[b];
+        int da = __builtin_popcountll(state.serverMask(a)), db = __builtin_popcountll(state.serverMask(b));
+        if (da != db) return da > db;
+        return a < b;
+    });
+
+    std::vector<int> part(state.servers);
+    for (size_t k = 0; k < order.size(); k++) part[order[k]] = k % parts;
+    return part;
+}
+
+// 按服务器数量成比例（最大余数法）给每个部分分配工程师
+inline std::vector<int> splitEngineers(int engineers, const std::vector<int>& part_servers) {
+    int parts = part_servers.size();
+    long long total = 0;
+    for (int n : part_servers) total += n;
+
+    std::vector<int> share(parts, 0);
+    std::vector<std::pair<long long, int>> remainder;
+    int assigned = 0;
+    for (int p = 0; p < parts; p++) {
+        long long scaled = total > 0 ? (long long)engineers * part_servers[p] : engineers;
+        long long base_total = total > 0 ? total : parts;
+        share[p] = scaled / base_total;
+        remainder.push_back({scaled % base_total, -p});
+        assigned += share[p];
+    }
+    std::sort(remainder.rbegin(), remainder.rend());
+    for (int k = 0; assigned < engineers; k = (k + 1) % parts) {
+        share[-remainder[k].second]++;
+        assigned++;
+    }
+    return share;
+}
+
+// 分解求解，结果写回 state（原有内容被替换）
+inline DecompositionStats solveDecomposed(AllocationState& state, const DecompositionOptions& options,
+                                          PartSolver part_solver = PartSolver()) {
+    auto now = []() { return std::chrono::steady_clock::now(); };
+    auto seconds = [](std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+    };
+    if (!part_solver) {
+        // 全局规模需要邻居表时，子问题即使低于阈值也用邻居表，否则各部分的精确扫描比整体还慢
+        int neighbor_min_servers = state.servers >= NEIGHBOR_LIST_MIN_SERVERS ? 0 : NEIGHBOR_LIST_MIN_SERVERS;
+        part_solver = [neighbor_min_servers](AllocationState& part, double time_limit) {
+            repairAndImprove(part, time_limit, neighbor_min_servers);
+        };
+    }
+
+    DecompositionStats stats;
+    auto start = now();
+    int threads = options.threads > 0 ? options.threads : solverPool().concurrency();
+    int parts = std::max(1, std::min(options.parts, std::min(state.engineers, std::max(1, state.servers))));
+    int strata = options.strata > 0 ? options.strata : 8 * parts;
+
+    MetricsStream& metrics = metricsStream();
+    metrics.setPhase("partition");
+    std::vector<int> part;
+    {
+        TRACE_SPAN("partition", "decompose");
+        part = partitionServers(state, parts, strata, options.kmeans_rounds, threads, options.seed);
+    }
+    std::vector<std::vector<int>> servers_of(parts);
+    for (int s = 0; s < state.servers; s++) servers_of[part[s]].push_back(s);
+
+    std::vector<int> part_servers(parts);
+    for (int p = 0; p < parts; p++) part_servers[p] = servers_of[p].size();
+    std::vector<int> share = splitEngineers(state.engineers, part_servers);
+    std::vector<int> first_engineer(parts, 0);
+    for (int p = 1; p < parts; p++) first_engineer[p] = first_engineer[p - 1] + share[p - 1];
+
+    stats.parts = parts;
+    stats.strata = strata;
+    stats.partition_seconds = seconds(start);
+
+    // 每个部分一个独立的状态，掩码按本地编号拷贝一份
+    std::vector<std::vector<uint64_t>> part_masks(parts);
+    std::vector<AllocationState> states(parts);
+    for (int p = 0; p < parts; p++) {
+        for (int s : servers_of[p]) part_masks[p].push_back(state.serverMask(s));
+        states[p].reset(part_masks[p].data(), part_masks[p].size(), state.first14_mask, share[p],
+                        part_masks[p].size(), state.slots, state.num_days);
+    }
+
+    auto solve_start = now();
+    double part_budget = std::max(0.0, options.time_limit * options.part_share - stats.partition_seconds);
+    // 子问题是长任务，低优先级提交；到了截止时间还没开始的部分直接跳过，留给全局修复。
+    // 线程比部分少时按剩余的轮数平分剩余时间
+    CancelToken deadline(part_budget);
+    TaskGroup group(&deadline);
+    std::atomic<int> started{0};
+    int lanes = std::min(parts, solverPool().concurrency());
+    metrics.setPhase("solve_parts");
+    for (int p = 0; p < parts; p++) {
+        solverPool().submit(group, [&, p]() {
+            TRACE_SPAN("solve_part", "decompose");
+            MetricsMute mute;
+            int waves = (parts - started++ + lanes - 1) / lanes;
+            part_solver(states[p], deadline.remaining() / std::max(1, waves));
+        }, TASK_LOW);
+    }
+    solverPool().wait(group);
+    stats.parts_skipped = group.skippedTasks();
+    stats.solve_seconds = seconds(solve_start);
+
+    // 合并：本地槽位原样映射回全局工程师和服务器
+    metrics.setPhase("merge");
+    {
+        TRACE_SPAN("merge", "decompose");
+        state.clearAll();
+        for (int p = 0; p < parts; p++) {
+            for (int e = 0; e < share[p]; e++) {
+                for (int i = 0; i < state.slots; i++) {
+                    int local = states[p].slotServer(e, i);
+                    if (local != -1) state.place(first_engineer[p] + e, i, servers_of[p][local]);
+                }
+            }
+        }
+    }
+    stats.merged_rest_days = state.total_rest_days;
+    stats.merged_first14_missing = state.first14_missing;
+    metrics.offerIncumbent(state);
+    metrics.setStat("parts", parts);
+    metrics.setStat("parts_skipped", stats.parts_skipped);
+    metrics.setStat("merged_rest_days", stats.merged_rest_days);
+
+    auto repair_start = now();
+    stats.repair = repairAndImprove(state, std::max(0.0, options.time_limit - seconds(start)));
+    stats.repair_seconds = seconds(repair_start);
+    return stats;
+}
+
+#endif
@@ -0,0 +1,762 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "alarm_index.h"
+#include "allocation_state.h"
+#include "local_search.h"
+#include "decomposition.h"
+
+using namespace std;
+
+// 多进程分布式求解：一个协调进程，若干工作进程通过 TCP 或 Unix 域套接字连接。
+//
+// 协调进程加载警报索引，每个工作进程连上来时把索引快照的原始字节发一次（SETUP，
+// 工作进程用 AlarmIndex::loadSnapshotBytes 装入，不需要警报文件），同时分配搜索方法
+// 和种子；之后只传方案。工作进程一轮一轮地搜索，每轮从它知道的最优方案出发，
+// 找到更好的就发回（IMPROVED）。协调进程在自己的状态上重新评估，确实更好就替换
+// 当前最优并广播给所有工作进程（INCUMBENT），工作进程下一轮从新方案重新出发。
+//
+// 消息是带长度的二进制帧：16 字节帧头 {type, reserved, length} + 负载，按本机字节序，
+// 协调进程和工作进程需要是同一种架构。
+//   工作 -> 协调：HELLO                      连接后的第一条消息
+//   协调 -> 工作：SETUP setup + 快照字节     每个连接只发一次
+//   协调 -> 工作：INCUMBENT version + 槽位    当前最优方案（int32，按工程师顺序，-1 为空位）
+//   工作 -> 协调：IMPROVED version + 槽位     基于 version 找到的更好方案
+//   协调 -> 工作：STOP
+//
+// 搜索方法（按连接顺序轮流分配，种子为 --seed 加连接编号）：
+//   perturb    随机清空若干工程师的槽位，再修复 + 局部搜索（迭代局部搜索）
+//   decompose  每轮换一个种子从头做分解求解（decomposition.h）
+//   repair     只做修复 + 局部搜索
+//
+// 本机测试：distributed_solver --local-workers 4 --time-limit 20 会 fork 出 4 个工作进程，
+// 也可以在其他终端或主机上运行 distributed_solver --worker ADDR。
+
+const int DEFAULT_ENGINEERS = 336;
+const int DEFAULT_SLOTS = 5;
+const uint64_t MAX_FRAME_BYTES = 1ULL << 32;
+
+enum MessageType : uint32_t {
+    MSG_HELLO = 1,
+    MSG_SETUP = 2,
+    MSG_INCUMBENT = 3,
+    MSG_IMPROVED = 4,
+    MSG_STOP = 5,
+    MSG_TYPE_COUNT
+};
+
+struct FrameHeader {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t length;
+};
+
+struct SetupMessage {
+    int32_t engineers;
+    int32_t servers;
+    int32_t slots;
+    int32_t days;
+    uint64_t seed;
+    double round_seconds;
+    char method[16];
+};
+
+struct DistributedConfig {
+    string alarm_file = "alarm_list.txt";
+    string address = "distributed.sock";
+    string worker_address;   // 非空时作为工作进程连接这个地址
+    string initial;
+    string output = "distributed_solution.txt";
+    vector<string> methods = {"perturb", "decompose", "repair"};
+    int engineers = DEFAULT_ENGINEERS;
+    int servers = 0;         // 0 表示使用警报文件的服务器数量
+    int slots = DEFAULT_SLOTS;
+    int days = 0;            // 0 表示使用警报文件的全部天数
+    int local_workers = 0;
+    double time_limit = 30.0;
+    double round_ms = 500.0;
+    uint64_t seed = 1;
+};
+
+typedef chrono::steady_clock Clock;
+
+static atomic<bool> stop_requested{false};
+
+static void handleSignal(int) {
+    stop_requested = true;
+}
+
+static double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// ---- 帧的读写 ----
+
+struct Frame {
+    uint32_t type = 0;
+    string payload;
+};
+
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+static string encodeFrame(uint32_t type, const string& payload) {
+    FrameHeader header = {type, 0, payload.size()};
+    string frame((const char*)&header, sizeof(header));
+    return frame + payload;
+}
+
+static bool sendFrame(int fd, uint32_t type, const string& payload = string()) {
+    string frame = encodeFrame(type, payload);
+    return writeAll(fd, frame.data(), frame.size());
+}
+
+// 按到达的字节拼帧，阻塞和非阻塞套接字都可以用
+class FrameReader {
+private:
+    string buffer;
+    size_t consumed = 0;
+    bool corrupt = false;
+    uint64_t max_length[MSG_TYPE_COUNT];  // 每种消息允许的最大负载长度，未知类型一律不合法
+
+public:
+    FrameReader() {
+        for (uint64_t& limit : max_length) limit = MAX_FRAME_BYTES;
+    }
+
+    // 只接受 type 类型、负载不超过 length 的帧（之后可以再放开其他类型）。
+    // 帧头一到就检查，对端声称的长度不合法时不会再为它缓冲负载
+    void only(uint32_t type, uint64_t length) {
+        for (uint64_t& limit : max_length) limit = 0;
+        allow(type, length);
+    }
+    void allow(uint32_t type, uint64_t length) { max_length[type] = length; }
+
+    // 收到过类型或长度不合法的帧，流已经无法再同步，只能关闭连接
+    bool broken() const { return corrupt; }
+
+    // 读一次套接字中已有的数据，连接关闭或出错时返回 false
+    bool fill(int fd) {
+        char chunk[65536];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (n <= 0) return false;
+        if (consumed > 0 && consumed == buffer.size()) {
+            buffer.clear();
+            consumed = 0;
+        }
+        buffer.append(chunk, n);
+        return true;
+    }
+
+    // 取出一个完整的帧；帧类型或长度不合法时返回 false 并标记 broken()
+    bool next(Frame& frame) {
+        if (corrupt || buffer.size() - consumed < sizeof(FrameHeader)) return false;
+        FrameHeader header;
+        memcpy(&header, buffer.data() + consumed, sizeof(header));
+        if (header.type == 0 || header.type >= MSG_TYPE_COUNT || header.length > max_length[header.type]) {
+            corrupt = true;
+            return false;
+        }
+        if (buffer.size() - consumed - sizeof(header) < header.length) return false;
+        frame.type = header.type;
+        frame.payload.assign(buffer, consumed + sizeof(header), header.length);
+        consumed += sizeof(header) + header.length;
+        if (consumed > (1u << 20) && consumed * 2 > buffer.size()) {
+            buffer.erase(0, consumed);
+            consumed = 0;
+        }
+        return true;
+    }
+
+    // 阻塞直到收到一个完整的帧
+    bool read(int fd, Frame& frame) {
+        while (!next(frame)) {
+            if (corrupt || !fill(fd)) return false;
+        }
+        return true;
+    }
+};
+
+// ---- 地址 ----
+
+// "HOST:PORT" 为 TCP（HOST 可以为空），"unix:PATH" 或不含冒号的路径为 Unix 域套接字
+struct SocketAddress {
+    bool tcp = false;
+    string host;
+    string port;
+    string path;
+};
+
+static SocketAddress parseAddress(const string& text) {
+    SocketAddress address;
+    size_t colon = text.rfind(':');
+    if (text.rfind("unix:", 0) == 0) {
+        address.path = text.substr(5);
+    } else if (colon != string::npos) {
+        address.tcp = true;
+        address.host = text.substr(0, colon);
+        address.port = text.substr(colon + 1);
+    } else {
+        address.path = text;
+    }
+    return address;
+}
+
+static int openSocket(const SocketAddress& address, bool passive) {
+    if (!address.tcp) {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (address.path.size() >= sizeof(addr.sun_path)) {
+            cerr << "Error: Socket path too long: " << address.path << endl;
+            return -1;
+        }
+        strcpy(addr.sun_path, address.path.c_str());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (passive) {
+            unlink(address.path.c_str());
+            if (bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0 && listen(fd, 64) == 0) return fd;
+        } else if (connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0) {
+            return fd;
+        }
+        close(fd);
+        return -1;
+    }
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    const char* host = address.host.empty() ? (passive ? nullptr : "127.0.0.1") : address.host.c_str();
+    addrinfo* results = nullptr;
+    if (getaddrinfo(host, address.port.c_str(), &hints, &results) != 0) return -1;
+
+    int fd = -1;
+    for (addrinfo* ai = results; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        int one = 1;
+        bool ok;
+        if (passive) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            ok = bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, 64) == 0;
+        } else {
+            ok = connect(fd, ai->ai_addr, ai->ai_addrlen) == 0;
+            if (ok) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        if (!ok) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(results);
+    return fd;
+}
+
+// ---- 方案 ----
+
+static string encodeSlots(uint64_t version, const AllocationState& state) {
+    string payload((const char*)&version, sizeof(version));
+    payload.append((const char*)state.slot_server.data(), state.slot_server.size() * sizeof(int32_t));
+    return payload;
+}
+
+// 按原位置装入槽位数组，越界和重复的服务器丢弃，返回丢弃的个数
+static int loadSlots(AllocationState& state, const string& payload, uint64_t& version) {
+    memcpy(&version, payload.data(), sizeof(version));
+    const char* data = payload.data() + sizeof(version);
+    state.clearAll();
+    int dropped = 0;
+    for (int e = 0; e < state.engineers; e++) {
+        for (int i = 0; i < state.slots; i++) {
+            int32_t server;
+            memcpy(&server, data + ((size_t)e * state.slots + i) * sizeof(int32_t), sizeof(server));
+            if (server == -1) continue;
+            if (server < 0 || server >= state.servers || state.owner[server] != -1) {
+                dropped++;
+                continue;
+            }
+            state.place(e, i, server);
+        }
+    }
+    return dropped;
+}
+
+static bool betterThan(const AllocationState& a, const AllocationState& b) {
+    return a.first14_missing < b.first14_missing ||
+           (a.first14_missing == b.first14_missing && a.total_rest_days < b.total_rest_days);
+}
+
+static bool saveAllocation(const AllocationState& state, const string& file_name) {
+    ofstream file(file_name);
+    if (!file.is_open()) return false;
+    for (int e = 0; e < state.engineers; e++) {
+        for (int i = 0; i < state.slots; i++) {
+            file << state.slotServer(e, i);
+            if (i < state.slots - 1) file << " ";
+        }
+        file << "\n";
+    }
+    return true;
+}
+
+// ---- 工作进程 ----
+
+// 一轮搜索，直接修改 state
+static void searchRound(AllocationState& state, const string& method, uint64_t seed, int round, double seconds) {
+    if (method == "decompose") {
+        DecompositionOptions options;
+        options.seed = seed + round;
+        options.time_limit = seconds;
+        solveDecomposed(state, options);
+        return;
+    }
+    if (method == "perturb") {
+        mt19937_64 rng(seed * 0x9E3779B97F4A7C15ULL + round);
+        int kicks = max(1, state.engineers / 50);
+        for (int k = 0; k < kicks; k++) {
+            int e = rng() % state.engineers;
+            for (int i = 0; i < state.slots; i++) state.clear(e, i);
+        }
+    }
+    repairAndImprove(state, seconds);
+}
+
+static int runWorker(const string& address_text) {
+    SocketAddress address = parseAddress(address_text);
+    int fd = -1;
+    // 协调进程可能还没开始监听，最多重试 10 秒
+    for (int attempt = 0; attempt < 100 && fd < 0 && !stop_requested; attempt++) {
+        fd = openSocket(address, false);
+        if (fd < 0) usleep(100000);
+    }
+    if (fd < 0) {
+        cerr << "Error: Cannot connect to " << address_text << endl;
+        return 1;
+    }
+
+    FrameReader reader;
+    Frame frame;
+    if (!sendFrame(fd, MSG_HELLO) || !reader.read(fd, frame) || frame.type != MSG_SETUP ||
+        frame.payload.size() < sizeof(SetupMessage)) {
+        cerr << "Error: No setup from coordinator" << endl;
+        close(fd);
+        return 1;
+    }
+
+    SetupMessage setup;
+    memcpy(&setup, frame.payload.data(), sizeof(setup));
+    setup.method[sizeof(setup.method) - 1] = '\0';
+    string method = setup.method;
+    AlarmIndex index;
+    if (!index.loadSnapshotBytes(frame.payload.data() + sizeof(setup), frame.payload.size() - sizeof(setup))) {
+        cerr << "Error: Invalid alarm index snapshot from coordinator" << endl;
+        close(fd);
+        return 1;
+    }
+    cout << "[worker " << getpid() << "] " << method << " seed " << setup.seed << ", " << index.numServers()
+         << " servers, snapshot " << index.snapshotSize() << " bytes" << endl;
+
+    AllocationState base;
+    base.reset(index, setup.engineers, setup.servers, setup.slots, setup.days);
+    const size_t slots_bytes = sizeof(uint64_t) + base.slot_server.size() * sizeof(int32_t);
+    uint64_t base_version = 0;
+    bool have_incumbent = false;
+
+    for (int round = 0; !stop_requested; round++) {
+        Clock::time_point round_start = Clock::now();
+
+        // 取走已经到达的消息，只保留最新的当前最优方案
+        bool closed = false, stop = false;
+        pollfd pfd = {fd, POLLIN, 0};
+        while (poll(&pfd, 1, 0) > 0) {
+            if (!reader.fill(fd)) {
+                closed = true;
+                break;
+            }
+        }
+        while (reader.next(frame)) {
+            if (frame.type == MSG_STOP) stop = true;
+            if (frame.type != MSG_INCUMBENT || frame.payload.size() != slots_bytes) continue;
+            uint64_t version;
+            memcpy(&version, frame.payload.data(), sizeof(version));
+            if (!have_incumbent || version > base_version) {
+                loadSlots(base, frame.payload, base_version);
+                have_incumbent = true;
+            }
+        }
+        if (reader.broken()) cerr << "Error: Invalid frame from coordinator" << endl;
+        if (closed || stop || reader.broken()) break;
+
+        AllocationState candidate = base;
+        searchRound(candidate, method, setup.seed, round, setup.round_seconds);
+
+        if (betterThan(candidate, base)) {
+            if (!sendFrame(fd, MSG_IMPROVED, encodeSlots(base_version, candidate))) break;
+            base = candidate;
+        } else {
+            // 没有进展时不空转，等到本轮的时间用完或者收到新的方案
+            double remaining = setup.round_seconds - secondsSince(round_start);
+            if (remaining > 0) poll(&pfd, 1, (int)(remaining * 1000));
+        }
+    }
+
+    close(fd);
+    return 0;
+}
+
+// ---- 协调进程 ----
+
+struct WorkerConnection {
+    int fd = -1;
+    int id = 0;
+    string method;
+    uint64_t seed = 0;
+    FrameReader reader;
+    string out;              // 还没写出去的字节（非阻塞写）
+    size_t out_pos = 0;
+    size_t incumbent_pos = string::npos;  // out 里最后一个 INCUMBENT 帧的起点
+    bool ready = false;      // 已经收到 HELLO
+    int accepted = 0;
+    int rejected = 0;
+};
+
+class Coordinator {
+private:
+    DistributedConfig config;
+    AlarmIndex index;
+    AllocationState incumbent;
+    AllocationState trial;
+    uint64_t version = 0;
+    int listen_fd = -1;
+    vector<WorkerConnection> connections;
+    vector<pid_t> children;
+    int next_id = 0;
+    Clock::time_point start;
+
+public:
+    explicit Coordinator(const DistributedConfig& cfg) : config(cfg) {}
+
+    bool initialize() {
+        if (!index.load(config.alarm_file)) return false;
+        int days = config.days > 0 ? min(config.days, index.numDays()) : index.numDays();
+        if (days > ALARM_INDEX_MASK_DAYS) {
+            cerr << "Error: distributed solving uses 64-bit day masks, at most " << ALARM_INDEX_MASK_DAYS
+                 << " days are supported (use --days)" << endl;
+            return false;
+        }
+        config.days = days;
+        if (config.servers <= 0) config.servers = index.numServers();
+        incumbent.reset(index, config.engineers, config.servers, config.slots, config.days);
+        trial = incumbent;
+
+        if (!config.initial.empty()) {
+            vector<vector<int>> allocation;
+            if (!loadAllocationFile(config.initial, config.slots, allocation)) return false;
+            incumbent.assignFrom(allocation);
+            cout << "Loaded initial allocation " << config.initial << ", rest days " << incumbent.total_rest_days << endl;
+        }
+
+        listen_fd = openSocket(parseAddress(config.address), true);
+        if (listen_fd < 0) {
+            cerr << "Error: Cannot listen on " << config.address << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // 在监听之后 fork，本机的工作进程和远程的走同一个协议
+    void spawnLocalWorkers() {
+        SocketAddress address = parseAddress(config.address);
+        string target = address.tcp && address.host.empty() ? "127.0.0.1:" + address.port : config.address;
+        cout.flush();
+        for (int i = 0; i < config.local_workers; i++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(listen_fd);
+                _exit(runWorker(target));
+            }
+            if (pid > 0) children.push_back(pid);
+        }
+    }
+
+    void run() {
+        start = Clock::now();
+        cout << "Coordinating on " << config.address << " for " << config.time_limit << "s ("
+             << config.engineers << " engineers, " << config.servers << " servers, " << config.days << " days, "
+             << index.snapshotSize() << " byte snapshot)" << endl;
+
+        while (!stop_requested && secondsSince(start) < config.time_limit) {
+            vector<pollfd> fds;
+            fds.push_back({listen_fd, POLLIN, 0});
+            for (WorkerConnection& c : connections) {
+                fds.push_back({c.fd, (short)(POLLIN | (c.out_pos < c.out.size() ? POLLOUT : 0)), 0});
+            }
+            if (poll(fds.data(), fds.size(), 100) <= 0) continue;
+
+            for (size_t k = 1; k < fds.size(); k++) {
+                WorkerConnection& c = connections[k - 1];
+                bool alive = true;
+                if (fds[k].revents & POLLOUT) alive = flush(c);
+                if (alive && (fds[k].revents & (POLLIN | POLLHUP | POLLERR))) alive = receive(c);
+                if (!alive) {
+                    cout << "Worker " << c.id << " disconnected" << endl;
+                    close(c.fd);
+                    c.fd = -1;
+                }
+            }
+            connections.erase(remove_if(connections.begin(), connections.end(),
+                                        [](const WorkerConnection& c) { return c.fd < 0; }),
+                              connections.end());
+
+            if (fds[0].revents & POLLIN) accept();
+        }
+
+        shutdown();
+    }
+
+private:
+    void accept() {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) return;
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        WorkerConnection c;
+        c.fd = fd;
+        c.id = next_id++;
+        c.method = config.methods[c.id % config.methods.size()];
+        c.seed = config.seed + c.id;
+        // 监听地址可能对所有网卡开放：HELLO 没有负载，IMPROVED 的长度是固定的，
+        // 其他帧在帧头到达时就拒绝，对端不能让协调进程缓冲任意多的数据
+        c.reader.only(MSG_HELLO, 0);
+        c.reader.allow(MSG_IMPROVED, sizeof(uint64_t) + incumbent.slot_server.size() * sizeof(int32_t));
+        connections.push_back(std::move(c));
+    }
+
+    // 读得慢的工作进程不会积压一串过时的方案：一个字节都还没写出的 INCUMBENT 帧
+    // 直接被新版本覆盖（帧长固定），每个连接最多只有一个待发的 INCUMBENT
+    void queue(WorkerConnection& c, uint32_t type, const string& payload) {
+        if (c.out_pos > 0) {
+            c.out.erase(0, c.out_pos);
+            if (c.incumbent_pos != string::npos) {
+                c.incumbent_pos = c.incumbent_pos >= c.out_pos ? c.incumbent_pos - c.out_pos : string::npos;
+            }
+            c.out_pos = 0;
+        }
+        string frame = encodeFrame(type, payload);
+        // 已经写出一部分的帧在上面丢掉了位置，这里剩下的都是一个字节也没写出的
+        if (type == MSG_INCUMBENT && c.incumbent_pos != string::npos && c.out.size() - c.incumbent_pos == frame.size()) {
+            c.out.replace(c.incumbent_pos, frame.size(), frame);
+        } else {
+            if (type == MSG_INCUMBENT) c.incumbent_pos = c.out.size();
+            c.out += frame;
+        }
+        flush(c);
+    }
+
+    bool flush(WorkerConnection& c) {
+        while (c.out_pos < c.out.size()) {
+            ssize_t n = write(c.fd, c.out.data() + c.out_pos, c.out.size() - c.out_pos);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+            if (n <= 0) return false;
+            c.out_pos += n;
+        }
+        return true;
+    }
+
+    bool receive(WorkerConnection& c) {
+        if (!c.reader.fill(c.fd)) return false;
+        Frame frame;
+        while (c.reader.next(frame)) {
+            if (frame.type == MSG_HELLO && !c.ready) {
+                c.ready = true;
+                SetupMessage setup;
+                memset(&setup, 0, sizeof(setup));
+                setup.engineers = config.engineers;
+                setup.servers = config.servers;
+                setup.slots = config.slots;
+                setup.days = config.days;
+                setup.seed = c.seed;
+                setup.round_seconds = config.round_ms / 1000.0;
+                strncpy(setup.method, c.method.c_str(), sizeof(setup.method) - 1);
+                string payload((const char*)&setup, sizeof(setup));
+                payload.append(index.snapshotData(), index.snapshotSize());
+                queue(c, MSG_SETUP, payload);
+                queue(c, MSG_INCUMBENT, encodeSlots(version, incumbent));
+                cout << "Worker " << c.id << " connected: " << c.method << " seed " << c.seed << endl;
+            } else if (frame.type == MSG_IMPROVED && c.ready &&
+                       frame.payload.size() == sizeof(uint64_t) + incumbent.slot_server.size() * sizeof(int32_t)) {
+                improved(c, frame.payload);
+            } else {
+                return false;
+            }
+        }
+        return !c.reader.broken();
+    }
+
+    // 在协调进程的状态上重新评估，不信任工作进程报告的数值
+    void improved(WorkerConnection& c, const string& payload) {
+        uint64_t base_version;
+        int dropped = loadSlots(trial, payload, base_version);
+        if (dropped > 0 || !betterThan(trial, incumbent)) {
+            c.rejected++;
+            return;
+        }
+
+        swap(incumbent, trial);
+        version++;
+        c.accepted++;
+        cout << "[" << secondsSince(start) << "s] worker " << c.id << " (" << c.method << ") improved to "
+             << incumbent.total_rest_days << " rest days, " << incumbent.first14_missing
+             << " engineers without first 14 days work (version " << version << ")" << endl;
+
+        string broadcast = encodeSlots(version, incumbent);
+        for (WorkerConnection& other : connections) {
+            if (other.ready && other.fd >= 0) queue(other, MSG_INCUMBENT, broadcast);
+        }
+    }
+
+    // 丢弃还没写出的广播，只发 STOP；工作进程收到 STOP 或连接关闭都会退出
+    void shutdown() {
+        string stop = encodeFrame(MSG_STOP, string());
+        for (WorkerConnection& c : connections) {
+            if (c.out_pos == 0 || c.out_pos == c.out.size()) {
+                if (write(c.fd, stop.data(), stop.size()) < 0) {}
+            }
+            close(c.fd);
+        }
+        close(listen_fd);
+        SocketAddress address = parseAddress(config.address);
+        if (!address.tcp) unlink(address.path.c_str());
+        for (pid_t pid : children) waitpid(pid, nullptr, 0);
+
+        cout << "\n=== Distributed Solver Summary ===" << endl;
+        for (const WorkerConnection& c : connections) {
+            cout << "Worker " << c.id << " (" << c.method << ", seed " << c.seed << "): " << c.accepted
+                 << " accepted, " << c.rejected << " rejected" << endl;
+        }
+        cout << "Rest days: " << incumbent.total_rest_days << ", engineers without first 14 days work: "
+             << incumbent.first14_missing << ", incumbent version " << version << endl;
+        if (saveAllocation(incumbent, config.output)) {
+            cout << "Saved allocation to " << config.output << endl;
+        } else {
+            cerr << "Error: Cannot create " << config.output << endl;
+        }
+    }
+};
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]            协调进程" << endl;
+    cout << "       " << program << " --worker ADDR        工作进程" << endl;
+    cout << "  --alarms FILE        警报文件 (默认 alarm_list.txt)" << endl;
+    cout << "  --listen ADDR        监听地址，HOST:PORT 或 Unix 域套接字路径 (默认 distributed.sock)" << endl;
+    cout << "  --local-workers N    在本机 fork 的工作进程数 (默认 0)" << endl;
+    cout << "  --methods LIST       分配给工作进程的搜索方法，逗号分隔 (默认 perturb,decompose,repair)" << endl;
+    cout << "  --time-limit SECONDS 总时间 (默认 30)" << endl;
+    cout << "  --round-ms MS        工作进程每轮搜索的时间 (默认 500)" << endl;
+    cout << "  --seed N             种子基数 (默认 1)" << endl;
+    cout << "  --initial FILE       初始分配方案 (默认为空)" << endl;
+    cout << "  --output FILE        结果文件 (默认 distributed_solution.txt)" << endl;
+    cout << "  --engineers N        工程师数量 (默认 " << DEFAULT_ENGINEERS << ")" << endl;
+    cout << "  --servers N          服务器数量 (默认使用警报文件的服务器数量)" << endl;
+    cout << "  --slots N            每个工程师最多负责的服务器 (默认 " << DEFAULT_SLOTS << ")" << endl;
+    cout << "  --days N             天数 (默认使用警报文件的全部天数)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    DistributedConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--worker") config.worker_address = value;
+        else if (arg == "--alarms") config.alarm_file = value;
+        else if (arg == "--listen") config.address = value;
+        else if (arg == "--local-workers") config.local_workers = stoi(value);
+        else if (arg == "--time-limit") config.time_limit = stod(value);
+        else if (arg == "--round-ms") config.round_ms = stod(value);
+        else if (arg == "--seed") config.seed = stoull(value);
+        else if (arg == "--initial") config.initial = value;
+        else if (arg == "--output") config.output = value;
+        else if (arg == "--engineers") config.engineers = stoi(value);
+        else if (arg == "--servers") config.servers = stoi(value);
+        else if (arg == "--slots") config.slots = stoi(value);
+        else if (arg == "--days") config.days = stoi(value);
+        else if (arg == "--methods") {
+            config.methods.clear();
+            stringstream ss(value);
+            string method;
+            while (getline(ss, method, ',')) {
+                if (method != "perturb" && method != "decompose" && method != "repair") {
+                    cerr << "Error: Unknown method " << method << endl;
+                    return 1;
+                }
+                config.methods.push_back(method);
+            }
+            if (config.methods.empty()) {
+                cerr << "Error: --methods is empty" << endl;
+                return 1;
+            }
+        } else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    if (!config.worker_address.empty()) return runWorker(config.worker_address);
+
+    cout << "=== Distributed Solver ===" << endl;
+    Coordinator coordinator(config);
+    if (!coordinator.initialize()) return 1;
+    coordinator.spawnLocalWorkers();
+    coordinator.run();
+    return 0;
+}
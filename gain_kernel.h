@@ -0,0 +1,324 @@
+#ifndef GAIN_KERNEL_H
+#define GAIN_KERNEL_H
+
+// 贪心分配的增益内核：对一个工程师的工作天掩码，一次计算一批服务器的
+// popcount(mask[s] & ~engineer_mask)（以及是否带来新的前14天工作），并返回最大值的位置；
+// 反方向对一台服务器一次计算所有工程师的 popcount(server_mask & ~engineer_mask[e])，
+// 组合成得分后再求 argmax（最大覆盖贪心第二阶段的精确模式）。
+//
+// 有 AVX-512（VPOPCNTDQ，每条指令 8 个掩码）、AVX2（4 个，nibble 查表 popcount）
+// 和标量三种实现，运行时按 CPU 选择；环境变量 GAIN_KERNEL=scalar|avx2|avx512 可以强制指定
+// （不会超过 CPU 支持的级别）。选中的 SIMD 级别第一次使用前先在固定输入上与标量实现
+// 逐项比对，结果不一致就降一级并在 stderr 报告，所以 SIMD 路径在第一次跑到的机器上就会被校验。
+//
+// 所有 argmax 的平局规则都与逐个比较 `if (score > best)` 相同：返回第一个取到最大值
+// 且严格大于 threshold 的位置，没有则返回 -1。
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <cstdio>
+
+#include <immintrin.h>
+
+#include "perf_counters.h"
+
+enum GainKernelLevel {
+    GAIN_KERNEL_SCALAR = 0,
+    GAIN_KERNEL_AVX2 = 1,
+    GAIN_KERNEL_AVX512 = 2
+};
+
+struct GainArgmax {
+    int index = -1;
+    int score = 0;
+};
+
+inline const char* gainKernelName(GainKernelLevel level) {
+    switch (level) {
+        case GAIN_KERNEL_AVX512: return "avx512";
+        case GAIN_KERNEL_AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+namespace gain_kernel_detail {
+
+inline int scoreOf(uint64_t mask, uint64_t engineer_mask, uint64_t first14_mask, int first14_bonus) {
+    uint64_t fresh = mask & ~engineer_mask;
+    return __builtin_popcountll(fresh) + ((fresh & first14_mask) ? first14_bonus : 0);
+}
+
+inline void bestServerScalar(const uint64_t* masks, size_t begin, size_t n, uint64_t engineer_mask,
+                             uint64_t first14_mask, int first14_bonus, GainArgmax& best) {
+    for (size_t i = begin; i < n; i++) {
+        int score = scoreOf(masks[i], engineer_mask, first14_mask, first14_bonus);
+        if (score > best.score) {
+            best.score = score;
+            best.index = i;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256i popcount64Avx2(__m256i v) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low4);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low4);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2")))
+inline void bestServerAvx2(const uint64_t* masks, size_t n, uint64_t engineer_mask, uint64_t first14_mask,
+                           int first14_bonus, GainArgmax& best) {
+    const __m256i eng = _mm256_set1_epi64x(engineer_mask);
+    const __m256i f14 = _mm256_set1_epi64x(first14_mask);
+    const __m256i bonus = _mm256_set1_epi64x(first14_bonus);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i fresh = _mm256_andnot_si256(eng, _mm256_loadu_si256((const __m256i*)(masks + i)));
+        __m256i score = popcount64Avx2(fresh);
+        __m256i no_f14 = _mm256_cmpeq_epi64(_mm256_and_si256(fresh, f14), zero);
+        score = _mm256_add_epi64(score, _mm256_andnot_si256(no_f14, bonus));
+
+        // 只有某个分量超过当前最优值时才逐个比较，平局规则与标量版本一致
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi64(score, _mm256_set1_epi64x(best.score)))) {
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256((__m256i*)lanes, score);
+            for (int k = 0; k < 4; k++) {
+                if (lanes[k] > best.score) {
+                    best.score = lanes[k];
+                    best.index = i + k;
+                }
+            }
+        }
+    }
+    bestServerScalar(masks, i, n, engineer_mask, first14_mask, first14_bonus, best);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+inline void bestServerAvx512(const uint64_t* masks, size_t n, uint64_t engineer_mask, uint64_t first14_mask,
+                             int first14_bonus, GainArgmax& best) {
+    const __m512i eng = _mm512_set1_epi64(engineer_mask);
+    const __m512i f14 = _mm512_set1_epi64(first14_mask);
+    const __m512i bonus = _mm512_set1_epi64(first14_bonus);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // 全掩码的 maskz 形式：GCC 的 _mm512_andnot_si512 以未定义向量为源，会触发 -Wmaybe-uninitialized
+        __m512i fresh = _mm512_maskz_andnot_epi64(0xFF, eng, _mm512_loadu_si512(masks + i));
+        __m512i score = _mm512_popcnt_epi64(fresh);
+        __mmask8 has_f14 = _mm512_test_epi64_mask(fresh, f14);
+        score = _mm512_mask_add_epi64(score, has_f14, score, bonus);
+
+        if (_mm512_cmpgt_epi64_mask(score, _mm512_set1_epi64(best.score))) {
+            alignas(64) int64_t lanes[8];
+            _mm512_store_si512(lanes, score);
+            for (int k = 0; k < 8; k++) {
+                if (lanes[k] > best.score) {
+                    best.score = lanes[k];
+                    best.index = i + k;
+                }
+            }
+        }
+    }
+    bestServerScalar(masks, i, n, engineer_mask, first14_mask, first14_bonus, best);
+}
+
+inline void coverageGainsScalar(const uint64_t* engineer_masks, size_t begin, size_t n, uint64_t server_mask,
+                                int32_t* gains) {
+    for (size_t i = begin; i < n; i++) gains[i] = __builtin_popcountll(server_mask & ~engineer_masks[i]);
+}
+
+__attribute__((target("avx2")))
+inline void coverageGainsAvx2(const uint64_t* engineer_masks, size_t n, uint64_t server_mask, int32_t* gains) {
+    const __m256i server = _mm256_set1_epi64x(server_mask);
+    const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i fresh = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(engineer_masks + i)), server);
+        __m256i counts = _mm256_permutevar8x32_epi32(popcount64Avx2(fresh), pack);
+        _mm_storeu_si128((__m128i*)(gains + i), _mm256_castsi256_si128(counts));
+    }
+    coverageGainsScalar(engineer_masks, i, n, server_mask, gains);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+inline void coverageGainsAvx512(const uint64_t* engineer_masks, size_t n, uint64_t server_mask, int32_t* gains) {
+    const __m512i server = _mm512_set1_epi64(server_mask);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i fresh = _mm512_maskz_andnot_epi64(0xFF, _mm512_loadu_si512(engineer_masks + i), server);
+        _mm256_storeu_si256((__m256i*)(gains + i), _mm512_maskz_cvtepi64_epi32(0xFF, _mm512_popcnt_epi64(fresh)));
+    }
+    coverageGainsScalar(engineer_masks, i, n, server_mask, gains);
+}
+
+inline void argmaxScalar(const int32_t* scores, size_t begin, size_t n, GainArgmax& best) {
+    for (size_t i = begin; i < n; i++) {
+        if (scores[i] > best.score) {
+            best.score = scores[i];
+            best.index = i;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+inline void argmaxAvx2(const int32_t* scores, size_t n, GainArgmax& best) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(scores + i));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(v, _mm256_set1_epi32(best.score)))) {
+            argmaxScalar(scores, i, i + 8, best);
+        }
+    }
+    argmaxScalar(scores, i, n, best);
+}
+
+__attribute__((target("avx512f")))
+inline void argmaxAvx512(const int32_t* scores, size_t n, GainArgmax& best) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(scores + i);
+        if (_mm512_cmpgt_epi32_mask(v, _mm512_set1_epi32(best.score))) {
+            argmaxScalar(scores, i, i + 16, best);
+        }
+    }
+    argmaxScalar(scores, i, n, best);
+}
+
+inline void bestServerAt(GainKernelLevel level, const uint64_t* masks, size_t n, uint64_t engineer_mask,
+                         uint64_t first14_mask, int first14_bonus, GainArgmax& best) {
+    switch (level) {
+        case GAIN_KERNEL_AVX512: bestServerAvx512(masks, n, engineer_mask, first14_mask, first14_bonus, best); break;
+        case GAIN_KERNEL_AVX2: bestServerAvx2(masks, n, engineer_mask, first14_mask, first14_bonus, best); break;
+        default: bestServerScalar(masks, 0, n, engineer_mask, first14_mask, first14_bonus, best); break;
+    }
+}
+
+inline void coverageGainsAt(GainKernelLevel level, const uint64_t* engineer_masks, size_t n, uint64_t server_mask,
+                            int32_t* gains) {
+    switch (level) {
+        case GAIN_KERNEL_AVX512: coverageGainsAvx512(engineer_masks, n, server_mask, gains); break;
+        case GAIN_KERNEL_AVX2: coverageGainsAvx2(engineer_masks, n, server_mask, gains); break;
+        default: coverageGainsScalar(engineer_masks, 0, n, server_mask, gains); break;
+    }
+}
+
+inline void argmaxAt(GainKernelLevel level, const int32_t* scores, size_t n, GainArgmax& best) {
+    switch (level) {
+        case GAIN_KERNEL_AVX512: argmaxAvx512(scores, n, best); break;
+        case GAIN_KERNEL_AVX2: argmaxAvx2(scores, n, best); break;
+        default: argmaxScalar(scores, 0, n, best); break;
+    }
+}
+
+// 在固定的伪随机输入上比对某一级实现和标量实现。长度取 8/16 的非整数倍以覆盖尾部，
+// 掩码成对重复以覆盖平局，得分里混入 INT_MIN（没有空槽位的工程师）
+inline bool selfCheck(GainKernelLevel level) {
+    const size_t n = 77;
+    uint64_t masks[n];
+    int32_t scores[n];
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    auto next = [&]() {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (size_t i = 0; i < n; i++) {
+        masks[i] = i % 5 == 4 ? masks[i - 1] : next() & (i % 3 == 0 ? 0x3FFFFFULL : ~0ULL);
+        scores[i] = i % 7 == 0 ? INT_MIN : (int32_t)(next() % 200) - 50;
+    }
+
+    for (int round = 0; round < 16; round++) {
+        uint64_t probe = round == 0 ? 0 : next();
+        uint64_t first14 = round % 2 ? (1ULL << 14) - 1 : 0;
+        int bonus = round % 4 < 2 ? 0 : 10;
+        int threshold = round % 3 == 0 ? -1 : (int)(next() % 40);
+        for (size_t len : {n, n - 5, (size_t)3}) {
+            GainArgmax expected, actual;
+            expected.score = actual.score = threshold;
+            bestServerScalar(masks, 0, len, probe, first14, bonus, expected);
+            bestServerAt(level, masks, len, probe, first14, bonus, actual);
+            if (expected.index != actual.index || expected.score != actual.score) return false;
+
+            int32_t gains_expected[n], gains_actual[n];
+            coverageGainsScalar(masks, 0, len, probe, gains_expected);
+            coverageGainsAt(level, masks, len, probe, gains_actual);
+            if (memcmp(gains_expected, gains_actual, len * sizeof(int32_t)) != 0) return false;
+
+            expected = actual = GainArgmax();
+            expected.score = actual.score = threshold;
+            argmaxScalar(scores, 0, len, expected);
+            argmaxAt(level, scores, len, actual);
+            if (expected.index != actual.index || expected.score != actual.score) return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace gain_kernel_detail
+
+inline GainKernelLevel detectGainKernelLevel() {
+    GainKernelLevel level = GAIN_KERNEL_SCALAR;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) level = GAIN_KERNEL_AVX2;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) level = GAIN_KERNEL_AVX512;
+
+    const char* env = getenv("GAIN_KERNEL");
+    if (env) {
+        GainKernelLevel requested = level;
+        if (strcmp(env, "scalar") == 0) requested = GAIN_KERNEL_SCALAR;
+        else if (strcmp(env, "avx2") == 0) requested = GAIN_KERNEL_AVX2;
+        else if (strcmp(env, "avx512") == 0) requested = GAIN_KERNEL_AVX512;
+        if (requested < level) level = requested;
+    }
+
+    while (level != GAIN_KERNEL_SCALAR && !gain_kernel_detail::selfCheck(level)) {
+        GainKernelLevel fallback = (GainKernelLevel)(level - 1);
+        fprintf(stderr, "gain_kernel: %s kernel disagrees with the scalar kernel, using %s\n",
+                gainKernelName(level), gainKernelName(fallback));
+        level = fallback;
+    }
+    return level;
+}
+
+inline GainKernelLevel gainKernelLevel() {
+    static const GainKernelLevel level = detectGainKernelLevel();
+    return level;
+}
+
+// 对一个工程师评估连续存放的服务器掩码：
+//   score[i] = popcount(masks[i] & ~engineer_mask) + (新增工作覆盖前14天 ? first14_bonus : 0)
+// 已分配的服务器可以在 masks 中置 0，它们的得分为 0，不会超过 threshold >= 0。
+inline GainArgmax bestServerGain(const uint64_t* masks, size_t n, uint64_t engineer_mask,
+                                 uint64_t first14_mask = 0, int first14_bonus = 0, int threshold = 0) {
+    PerfScope scope(PERF_GAIN_SCAN);
+    GainArgmax best;
+    best.score = threshold;
+    gain_kernel_detail::bestServerAt(gainKernelLevel(), masks, n, engineer_mask, first14_mask, first14_bonus, best);
+    return best;
+}
+
+// 反过来对一台服务器评估所有工程师：gains[i] = popcount(server_mask & ~engineer_masks[i])
+inline void coverageGains(const uint64_t* engineer_masks, size_t n, uint64_t server_mask, int32_t* gains) {
+    PerfScope scope(PERF_GAIN_SCAN);
+    gain_kernel_detail::coverageGainsAt(gainKernelLevel(), engineer_masks, n, server_mask, gains);
+}
+
+// 组合好的整数得分的 argmax（AVX2 每条指令 8 个，AVX-512 16 个），平局规则同上
+inline GainArgmax argmaxScore(const int32_t* scores, size_t n, int threshold) {
+    GainArgmax best;
+    best.score = threshold;
+    gain_kernel_detail::argmaxAt(gainKernelLevel(), scores, n, best);
+    return best;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#include <iostream>
+
+#include "gain_kernel.h"
+
+using namespace std;
+
+// 增益内核的标量等价检查：对 CPU 支持的每一级 SIMD 实现运行 gain_kernel.h 的自检，
+// 任何一级与标量实现不一致都以退出码 1 结束。求解器启动时也会做同样的检查，
+// 但只会静默降级；在 AVX-512 机器上的 CI 里跑这个程序才能发现回归。
+// 构建：
+//   g++ -std=c++17 -O2 -o gain_kernel_check gain_kernel_check.cpp
+
+int main() {
+    __builtin_cpu_init();
+    bool supported[] = {
+        true,
+        (bool)__builtin_cpu_supports("avx2"),
+        __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"),
+    };
+
+    bool ok = true;
+    for (int level = GAIN_KERNEL_SCALAR; level <= GAIN_KERNEL_AVX512; level++) {
+        const char* name = gainKernelName((GainKernelLevel)level);
+        if (!supported[level]) {
+            cout << name << ": not supported by this CPU, skipped" << endl;
+            continue;
+        }
+        bool passed = gain_kernel_detail::selfCheck((GainKernelLevel)level);
+        cout << name << ": " << (passed ? "matches scalar" : "MISMATCH") << endl;
+        ok = ok && passed;
+    }
+    cout << "selected: " << gainKernelName(gainKernelLevel()) << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+// 工具程序输出 JSON 时共用的字符串写法：加引号，转义引号、反斜杠和控制字符。
+// 文件名、错误信息等可能带有任意字节，不转义就会让整行输出不是合法 JSON。
+
+#include <string>
+#include <cstdio>
+
+inline void writeJsonString(std::string& out, const std::string& value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+#endif
@@ -0,0 +1,586 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+// 在 AllocationState 上做修复和局部搜索，用于从已有方案热启动。
+//
+// repairFirst14  为没有前14天工作的工程师补一台覆盖前14天的服务器（可以给一个截止时间）
+// fillEmptySlots 把未分配的服务器放进空槽位（工作天增加最多的优先）
+// parallelMoveSweep 多线程为一批工程师评估所有替换/转移/交换移动，
+//   选出互不冲突（不共享工程师和服务器）的改进移动一次性提交
+// improveAllocation 首次改进的局部搜索：
+//   - 用未分配服务器替换某个槽位
+//   - 两个工程师之间交换/转移一个槽位（转移即与空槽位交换）
+// repairAndImprove 依次做修复、填充、批量扫描，最后用首次改进搜索收尾。
+// 每一步都保持每个工程师在前14天有工作，只接受总休息天数严格下降的移动。
+//
+// 传入 NeighborLists 时，批量扫描和首次改进搜索不再枚举所有未分配服务器和所有
+// 工程师的槽位，只看工程师现有服务器的互补邻居：邻居未分配就试替换，
+// 已分配就试与它的负责人交换。修复和填充阶段从未分配服务器池中轮转取一个有界的窗口，
+// 不再对每个工程师扫描整个池；修复前14天时如果要从别的工程师那里换服务器，只看邻居的
+// 负责人和一个轮转的工程师窗口。服务器规模很大时 repairAndImprove 自动启用。
+//
+// 打开 SOLVER_TRACE 时各阶段记为区间，尝试/接受的移动数记为累计计数器（见 trace.h）；
+// 打开 SOLVER_METRICS 时移动数、当前值和更好的方案报告给进度流（见 metrics_stream.h）。
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cstdint>
+
+#include "allocation_state.h"
+#include "neighbor_lists.h"
+#include "task_pool.h"
+#include "trace.h"
+#include "perf_counters.h"
+#include "metrics_stream.h"
+
+// 使用邻居表时，修复/填充每个工程师最多查看的未分配服务器数
+const size_t SAMPLED_SCAN_LIMIT = 4096;
+// 使用邻居表时，修复前14天换服务器最多查看的其他工程师数（邻居的负责人 + 轮转窗口）
+const size_t SAMPLED_DONOR_LIMIT = 256;
+
+struct LocalSearchStats {
+    int first14_repaired = 0;
+    int slots_filled = 0;
+    int sweeps = 0;
+    long long sweep_moves = 0;
+    long long moves = 0;
+    int rounds = 0;
+    double seconds = 0.0;
+};
+
+inline std::vector<int> unassignedServers(const AllocationState& state) {
+    std::vector<int> servers;
+    for (int s = 0; s < state.servers; s++) {
+        if (state.owner[s] == -1) servers.push_back(s);
+    }
+    return servers;
+}
+
+// deadline 之后不再修复剩下的工程师（在线模式每天的修复有时间上限，没修完的留到下一天）。
+// unassigned 是调用方增量维护的未分配服务器列表（可以含已经分配出去的，会被跳过），
+// 换下来的服务器追加进去；不提供时扫描全部服务器现建一份
+inline int repairFirst14(AllocationState& state, const NeighborLists* neighbors = nullptr,
+                         std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(),
+                         std::vector<int>* unassigned = nullptr) {
+    int repaired = 0;
+    std::vector<int> own_pool;
+    if (!unassigned) own_pool = unassignedServers(state);
+    std::vector<int>& pool = unassigned ? *unassigned : own_pool;
+    size_t cursor = 0;
+    std::vector<int> candidates, donors;
+    size_t donor_cursor = 0;
+    // 轮转窗口按与工程师数互质的步长跳着取，编号相邻的工程师往往情况相似（例如都没有服务器）
+    size_t donor_stride = std::max<size_t>(1, (size_t)(state.engineers * 0.618));
+    while (std::gcd(donor_stride, (size_t)state.engineers) != 1) donor_stride++;
+
+    for (int e = 0; e < state.engineers; e++) {
+        if (state.hasFirst14(e)) continue;
+        if (std::chrono::steady_clock::now() >= deadline) break;
+
+        // 先在未分配的服务器中找覆盖前14天的，放进空位或替换损失最小的槽位
+        int best_gain = -1000000, best_slot = -1, best_server = -1;
+        int free_slot = state.freeSlot(e);
+        int current = state.workDays(e);
+        size_t scan = neighbors ? std::min(pool.size(), SAMPLED_SCAN_LIMIT) : pool.size();
+        for (size_t k = 0; k < scan; k++) {
+            int s = pool[neighbors ? (cursor + k) % pool.size() : k];
+            if (state.owner[s] != -1) continue;
+            uint64_t mask = state.serverMask(s);
+            if (!(mask & state.first14_mask)) continue;
+
+            for (int i = 0; i < state.slots; i++) {
+                if (free_slot != -1 && i != free_slot) continue;
+                int gain = __builtin_popcountll(state.maskWithout(e, i) | mask) - current;
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_slot = i;
+                    best_server = s;
+                }
+            }
+        }
+        cursor += scan;
+
+        if (best_server != -1) {
+            int removed = state.slotServer(e, best_slot);
+            state.replace(e, best_slot, best_server);
+            if (removed != -1) pool.push_back(removed);
+            repaired++;
+            continue;
+        }
+
+        // 没有可用的未分配服务器：从其他工程师那里换一台，对方必须仍然保留前14天的工作。
+        // 使用邻居表时只看 e 的服务器的邻居的负责人，加上轮转窗口里的工程师补足 SAMPLED_DONOR_LIMIT 个
+        donors.clear();
+        if (neighbors) {
+            neighbors->sample(state, e, candidates);
+            for (int s : candidates) {
+                int d = state.owner[s];
+                if (d != -1 && d != e && donors.size() < SAMPLED_DONOR_LIMIT) donors.push_back(d);
+            }
+            size_t window = std::min((size_t)state.engineers, SAMPLED_DONOR_LIMIT - donors.size());
+            for (size_t t = 0; t < window; t++) {
+                donors.push_back((donor_cursor + t) % state.engineers * donor_stride % state.engineers);
+            }
+            donor_cursor += window;
+            std::sort(donors.begin(), donors.end());
+            donors.erase(std::unique(donors.begin(), donors.end()), donors.end());
+        } else {
+            for (int d = 0; d < state.engineers; d++) donors.push_back(d);
+        }
+
+        int best_delta = -1000000, best_i = -1, best_d = -1, best_j = -1;
+        for (int d : donors) {
+            if (d == e) continue;
+            int current_d = state.workDays(d);
+            for (int j = 0; j < state.slots; j++) {
+                int server = state.slotServer(d, j);
+                if (server == -1) continue;
+                uint64_t mask = state.serverMask(server);
+                uint64_t rest_d = state.maskWithout(d, j);
+                if (!(mask & state.first14_mask) || !(rest_d & state.first14_mask)) continue;
+
+                for (int i = 0; i < state.slots; i++) {
+                    if (free_slot != -1 && i != free_slot) continue;
+                    int given = state.slotServer(e, i);
+                    uint64_t new_d = rest_d | (given == -1 ? 0 : state.serverMask(given));
+                    int delta = __builtin_popcountll(state.maskWithout(e, i) | mask) - current +
+                                __builtin_popcountll(new_d) - current_d;
+                    if (delta > best_delta) {
+                        best_delta = delta;
+                        best_i = i;
+                        best_d = d;
+                        best_j = j;
+                    }
+                }
+            }
+        }
+
+        if (best_d != -1) {
+            state.exchange(e, best_i, best_d, best_j);
+            repaired++;
+        }
+    }
+
+    return repaired;
+}
+
+inline int fillEmptySlots(AllocationState& state, const NeighborLists* neighbors = nullptr,
+                          std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+    std::vector<int> pool = unassignedServers(state);
+    std::vector<int> candidates;
+    size_t cursor = 0;
+    const size_t from_neighbors = (size_t)-1;
+    std::vector<int> order(state.engineers);
+    for (int e = 0; e < state.engineers; e++) order[e] = e;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return state.restDays(a) > state.restDays(b); });
+
+    int filled = 0;
+    bool placed = true;
+    while (placed && !pool.empty()) {
+        placed = false;
+        for (int e : order) {
+            int slot = state.freeSlot(e);
+            if (slot == -1) continue;
+            if (std::chrono::steady_clock::now() >= deadline) return filled;
+
+            int best_gain = -1, best_server = -1;
+            size_t best_pos = 0;
+            // 邻居表里的候选放置之后不从池中删除，池里扫到已分配的直接跳过
+            if (neighbors) {
+                neighbors->sample(state, e, candidates);
+                for (int s : candidates) {
+                    if (state.owner[s] != -1) continue;
+                    int gain = __builtin_popcountll(state.serverMask(s) & ~state.work_mask[e]);
+                    if (gain > best_gain) {
+                        best_gain = gain;
+                        best_server = s;
+                        best_pos = from_neighbors;
+                    }
+                }
+            }
+            size_t scan = neighbors ? std::min(pool.size(), SAMPLED_SCAN_LIMIT) : pool.size();
+            for (size_t k = 0; k < scan; k++) {
+                size_t p = neighbors ? (cursor + k) % pool.size() : k;
+                if (state.owner[pool[p]] != -1) continue;
+                int gain = __builtin_popcountll(state.serverMask(pool[p]) & ~state.work_mask[e]);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_server = pool[p];
+                    best_pos = p;
+                }
+            }
+            cursor += scan;
+            if (best_gain < 0) break;
+
+            state.place(e, slot, best_server);
+            if (best_pos != from_neighbors) {
+                pool[best_pos] = pool.back();
+                pool.pop_back();
+            }
+            filled++;
+            placed = true;
+        }
+    }
+
+    return filled;
+}
+
+struct SweepMove {
+    int gain;
+    int engineer1, slot1;
+    int engineer2, slot2;  // engineer2 == -1 表示用未分配的 server 替换 engineer1 的 slot1
+    int server;
+};
+
+struct SweepStats {
+    long long candidates = 0;
+    int applied = 0;
+    int gain = 0;
+};
+
+// 一次批量扫描：
+//   1. 多个线程并行地为 batch 中每个工程师评估所有移动，每人保留收益最高的 per_engineer 个；
+//   2. 按收益从高到低贪心选出互不冲突的移动（不共享工程师，也不共享同一台未分配服务器）；
+//   3. 一次性提交。被选中的移动互不相交，所以各自的收益可以直接相加。
+inline SweepStats parallelMoveSweep(AllocationState& state, const std::vector<int>& batch, int threads,
+                                    int per_engineer = 4, const NeighborLists* neighbors = nullptr) {
+    TRACE_SPAN("move_sweep", "local_search");
+    const int slots = state.slots;
+    const uint64_t* without = state.without_mask.data();  // 扫描期间状态不变，直接读留一掩码
+
+    std::vector<int> pool;
+    if (!neighbors) {
+        for (int s : unassignedServers(state)) {
+            if (state.serverMask(s)) pool.push_back(s);
+        }
+    }
+
+    auto keeps = [&](int e, uint64_t new_mask) {
+        return !state.hasFirst14(e) || (new_mask & state.first14_mask);
+    };
+
+    threads = std::max(1, std::min(threads, (int)batch.size()));
+    std::vector<std::vector<SweepMove>> found(threads);
+    std::vector<long long> evaluated(threads, 0);
+
+    auto worker = [&](int t) {
+        TRACE_SPAN("sweep_evaluate", "local_search");
+        PerfScope perf(PERF_DELTA_EVAL);
+        std::vector<SweepMove> best;
+        std::vector<int> candidates;
+        long long count = 0;
+        for (size_t k = t; k < batch.size(); k += threads) {
+            int e = batch[k];
+            int work_e = state.workDays(e);
+            best.clear();
+
+            auto offer = [&](const SweepMove& move) {
+                if ((int)best.size() < per_engineer) {
+                    best.push_back(move);
+                } else {
+                    auto worst = std::min_element(best.begin(), best.end(),
+                        [](const SweepMove& a, const SweepMove& b) { return a.gain < b.gain; });
+                    if (move.gain > worst->gain) *worst = move;
+                }
+            };
+
+            if (neighbors) neighbors->sample(state, e, candidates);
+
+            for (int i = 0; i < slots; i++) {
+                uint64_t base = without[(size_t)e * slots + i];
+                int own = state.slotServer(e, i);
+                uint64_t own_mask = own == -1 ? 0 : state.serverMask(own);
+
+                auto tryReplace = [&](int s) {
+                    uint64_t new_e = base | state.serverMask(s);
+                    int gain = __builtin_popcountll(new_e) - work_e;
+                    count++;
+                    if (gain > 0 && keeps(e, new_e)) offer({gain, e, i, -1, -1, s});
+                };
+                auto tryExchange = [&](int d, int j) {
+                    int other = state.slotServer(d, j);
+                    if (other == -1 && own == -1) return;
+                    uint64_t new_e = base | (other == -1 ? 0 : state.serverMask(other));
+                    uint64_t new_d = without[(size_t)d * slots + j] | own_mask;
+                    int gain = __builtin_popcountll(new_e) - work_e + __builtin_popcountll(new_d) - state.workDays(d);
+                    count++;
+                    if (gain > 0 && keeps(e, new_e) && keeps(d, new_d)) offer({gain, e, i, d, j, -1});
+                };
+
+                if (neighbors) {
+                    for (int s : candidates) {
+                        int d = state.owner[s];
+                        if (d == -1) {
+                            tryReplace(s);
+                        } else if (d != e) {
+                            tryExchange(d, state.slotOf(d, s));
+                        }
+                    }
+                    continue;
+                }
+
+                for (int s : pool) tryReplace(s);
+
+                for (int d = 0; d < state.engineers; d++) {
+                    if (d == e) continue;
+                    for (int j = 0; j < slots; j++) tryExchange(d, j);
+                }
+            }
+            found[t].insert(found[t].end(), best.begin(), best.end());
+        }
+        evaluated[t] = count;
+    };
+
+    solverPool().parallelChunks(threads, threads, [&](int t, size_t, size_t) { worker(t); });
+
+    SweepStats stats;
+    std::vector<SweepMove> moves;
+    for (int t = 0; t < threads; t++) {
+        stats.candidates += evaluated[t];
+        moves.insert(moves.end(), found[t].begin(), found[t].end());
+    }
+    std::sort(moves.begin(), moves.end(), [](const SweepMove& a, const SweepMove& b) {
+        if (a.gain != b.gain) return a.gain > b.gain;
+        if (a.engineer1 != b.engineer1) return a.engineer1 < b.engineer1;
+        if (a.slot1 != b.slot1) return a.slot1 < b.slot1;
+        if (a.engineer2 != b.engineer2) return a.engineer2 < b.engineer2;
+        if (a.slot2 != b.slot2) return a.slot2 < b.slot2;
+        return a.server < b.server;
+    });
+
+    std::vector<uint8_t> engineer_used(state.engineers, 0);
+    std::vector<uint8_t> server_used(state.servers, 0);
+    for (const SweepMove& move : moves) {
+        if (engineer_used[move.engineer1]) continue;
+        if (move.engineer2 == -1) {
+            if (server_used[move.server]) continue;
+            server_used[move.server] = 1;
+            state.replace(move.engineer1, move.slot1, move.server);
+        } else {
+            if (engineer_used[move.engineer2]) continue;
+            engineer_used[move.engineer2] = 1;
+            state.exchange(move.engineer1, move.slot1, move.engineer2, move.slot2);
+        }
+        engineer_used[move.engineer1] = 1;
+        stats.applied++;
+        stats.gain += move.gain;
+    }
+    metricsStream().addMoves(stats.candidates, stats.applied);
+    return stats;
+}
+
+inline long long improveAllocation(AllocationState& state, double time_limit, int& rounds,
+                                   const NeighborLists* neighbors = nullptr) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const int slots = state.slots;
+
+    long long moves = 0;
+    long long tried = 0;
+    rounds = 0;
+    bool improved = true;
+
+    while (improved && elapsed() < time_limit) {
+        TRACE_SPAN("improve_round", "local_search");
+        PerfScope perf(PERF_DELTA_EVAL);
+        long long round_tried = tried, round_moves = moves;
+        improved = false;
+        rounds++;
+
+        std::vector<int> pool;
+        if (!neighbors) {
+            for (int s : unassignedServers(state)) {
+                if (state.serverMask(s)) pool.push_back(s);
+            }
+        }
+        std::vector<int> candidates;
+
+        std::vector<int> order(state.engineers);
+        for (int e = 0; e < state.engineers; e++) order[e] = e;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int a, int b) { return state.restDays(a) > state.restDays(b); });
+
+        for (int e : order) {
+            if (state.restDays(e) == 0) break;
+            if (elapsed() >= time_limit) break;
+
+            bool moved = true;
+            while (moved) {
+                moved = false;
+                int current = state.workDays(e);
+                if (neighbors) neighbors->sample(state, e, candidates);
+
+                for (int i = 0; i < slots && !moved; i++) {
+                    uint64_t base = state.maskWithout(e, i);
+                    int own = state.slotServer(e, i);
+                    uint64_t own_mask = own == -1 ? 0 : state.serverMask(own);
+
+                    // 邻居未分配就替换，已分配就与它的负责人交换
+                    if (neighbors) {
+                        for (int s : candidates) {
+                            int d = state.owner[s];
+                            if (d == e) continue;
+                            tried++;
+                            uint64_t new_e = base | state.serverMask(s);
+                            if (!(new_e & state.first14_mask)) continue;
+                            int delta = __builtin_popcountll(new_e) - current;
+                            if (d == -1) {
+                                if (delta <= 0) continue;
+                                state.replace(e, i, s);
+                            } else {
+                                int j = state.slotOf(d, s);
+                                uint64_t new_d = state.maskWithout(d, j) | own_mask;
+                                if (!(new_d & state.first14_mask)) continue;
+                                if (delta + __builtin_popcountll(new_d) - state.workDays(d) <= 0) continue;
+                                state.exchange(e, i, d, j);
+                            }
+                            moved = true;
+                            break;
+                        }
+                        continue;
+                    }
+
+                    // 用未分配的服务器替换
+                    for (size_t p = 0; p < pool.size(); p++) {
+                        int s = pool[p];
+                        if (state.owner[s] != -1) continue;
+                        tried++;
+                        uint64_t new_e = base | state.serverMask(s);
+                        if (!(new_e & state.first14_mask)) continue;
+                        if (__builtin_popcountll(new_e) > current) {
+                            state.replace(e, i, s);
+                            pool[p] = own;
+                            if (own == -1 || !own_mask) {
+                                pool[p] = pool.back();
+                                pool.pop_back();
+                            }
+                            moved = true;
+                            break;
+                        }
+                    }
+                    if (moved) break;
+
+                    // 与其他工程师交换或转移一个槽位
+                    for (int d = 0; d < state.engineers && !moved; d++) {
+                        if (d == e) continue;
+                        int current_d = state.workDays(d);
+                        for (int j = 0; j < slots; j++) {
+                            int other = state.slotServer(d, j);
+                            if (other == -1 && own == -1) continue;
+                            tried++;
+                            uint64_t other_mask = other == -1 ? 0 : state.serverMask(other);
+                            uint64_t new_e = base | other_mask;
+                            uint64_t new_d = state.maskWithout(d, j) | own_mask;
+                            if (!(new_e & state.first14_mask) || !(new_d & state.first14_mask)) continue;
+
+                            int delta = __builtin_popcountll(new_e) - current +
+                                        __builtin_popcountll(new_d) - current_d;
+                            if (delta > 0) {
+                                state.exchange(e, i, d, j);
+                                moved = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                if (moved) {
+                    moves++;
+                    improved = true;
+                    if (state.restDays(e) == 0) break;
+                }
+            }
+        }
+        traceCounter("improve_moves_tried", tried);
+        traceCounter("improve_moves_accepted", moves);
+        metricsStream().addMoves(tried - round_tried, moves - round_moves);
+        metricsStream().offerIncumbent(state);
+    }
+
+    return moves;
+}
+
+// 修复 + 填充 + 局部搜索，time_limit 只约束局部搜索阶段；deadline 约束所有阶段，
+// 到了就停下，修复和填充可能只完成一部分。neighbors 是调用方建好的邻居表（可以为空），
+// 常驻进程每次载入数据建一次，之后每个请求复用，不把建表的时间算进请求里
+inline LocalSearchStats repairAndImproveWith(AllocationState& state, double time_limit, const NeighborLists* neighbors,
+                                             std::chrono::steady_clock::time_point deadline =
+                                                 std::chrono::steady_clock::time_point::max()) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    if (deadline != std::chrono::steady_clock::time_point::max()) {
+        time_limit = std::min(time_limit, std::chrono::duration<double>(deadline - start).count());
+    }
+    LocalSearchStats stats;
+
+    TRACE_SPAN("repair_and_improve", "local_search");
+    MetricsStream& metrics = metricsStream();
+    int threads = solverPool().concurrency();
+    const NeighborLists* sampled = neighbors && !neighbors->empty() ? neighbors : nullptr;
+
+    metrics.setPhase("repair");
+    {
+        TRACE_SPAN("repair", "local_search");
+        stats.first14_repaired = repairFirst14(state, sampled, deadline);
+        stats.slots_filled = fillEmptySlots(state, sampled, deadline);
+    }
+    metrics.offerIncumbent(state);
+    metrics.setPhase("batched_sweeps");
+
+    // 批量扫描每次提交一批互不冲突的改进，收益变少后交给首次改进搜索收尾
+    long long sweep_candidates = 0;
+    while (elapsed() < time_limit) {
+        std::vector<int> batch;
+        for (int e = 0; e < state.engineers; e++) {
+            if (state.restDays(e) > 0) batch.push_back(e);
+        }
+        SweepStats sweep = parallelMoveSweep(state, batch, threads, 4, sampled);
+        stats.sweeps++;
+        stats.sweep_moves += sweep.applied;
+        sweep_candidates += sweep.candidates;
+        traceCounter("sweep_moves_tried", sweep_candidates);
+        traceCounter("sweep_moves_accepted", stats.sweep_moves);
+        traceCounter("rest_days", state.total_rest_days);
+        metrics.offerIncumbent(state);
+        if (sweep.applied == 0) break;
+    }
+
+    metrics.setPhase("first_improvement");
+    stats.moves = improveAllocation(state, std::max(0.0, time_limit - elapsed()), stats.rounds, sampled);
+    traceCounter("rest_days", state.total_rest_days);
+    metrics.setStat("sweeps", stats.sweeps);
+    metrics.setStat("sweep_moves", stats.sweep_moves);
+    metrics.setStat("improve_rounds", stats.rounds);
+    metrics.setStat("improve_moves", stats.moves);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+// 同上，服务器很多时先建互补邻居表（只取决于服务器掩码），之后各阶段只从邻居和有界窗口里取候选。
+// neighbor_min_servers：服务器数达到这个值才建邻居表（分解求解的子问题沿用全局规模的判断）
+inline LocalSearchStats repairAndImprove(AllocationState& state, double time_limit,
+                                         int neighbor_min_servers = NEIGHBOR_LIST_MIN_SERVERS,
+                                         std::chrono::steady_clock::time_point deadline =
+                                             std::chrono::steady_clock::time_point::max()) {
+    auto start = std::chrono::steady_clock::now();
+    NeighborLists neighbors;
+    if (state.servers >= neighbor_min_servers) {
+        metricsStream().setPhase("neighbor_lists");
+        TRACE_SPAN("neighbor_lists", "local_search");
+        neighbors.build(state, solverPool().concurrency(), NeighborListConfig(), deadline);
+    }
+    double spent = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LocalSearchStats stats = repairAndImproveWith(state, std::max(0.0, time_limit - spent), &neighbors, deadline);
+    stats.seconds += spent;
+    return stats;
+}
+
+#endif
@@ -0,0 +1,396 @@
+#ifndef METRICS_STREAM_H
+#define METRICS_STREAM_H
+
+// 长时间运行的结构化进度流：按固定间隔输出一行 JSON（NDJSON），供看板跟踪收敛过程。
+//
+//   SOLVER_METRICS=FILE | unix:PATH | tcp:HOST:PORT   输出位置（文件按追加方式打开）
+//   SOLVER_METRICS_INTERVAL_MS                        输出间隔，默认 1000
+//   SOLVER_DUMP_FILE                                  收到 SIGUSR1 时写出当前最优方案的文件，
+//                                                     默认 incumbent_dump.txt
+// 两个变量都没有设置时完全关闭，每个埋点只是一次布尔判断。
+//
+// 每行包含：当前阶段、最优和当前的总休息天数、前14天缺失数、下界与差距、与目标（MAX_REST_DAYS）
+// 的差距、区间内每秒尝试的移动数和接受率、策略自己的统计（setStat）以及 RSS。
+// 求解器通过 reportCurrent / offerIncumbent 报告进度，当前最优用 SharedIncumbent 保存，
+// 输出线程和 SIGUSR1 都只读它，不打断求解线程。信号处理函数只设置一个原子标志，
+// 写文件由输出线程完成；格式与方案文件相同，可以直接用于 --warm-start。
+//
+// 分解求解的子问题在局部编号上搜索，用 MetricsMute 屏蔽它们的阶段、统计、当前值和方案
+// （移动计数照常累计）。
+
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "allocation_state.h"
+#include "shared_incumbent.h"
+
+class MetricsStream {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    bool stream_enabled = false;
+    bool active_ = false;
+    std::string target;
+    std::string dump_file = "incumbent_dump.txt";
+    int interval_ms = 1000;
+    int fd = -1;
+
+    std::string strategy;
+    long long lower_bound = 0;
+    long long rest_target = 0;
+    Clock::time_point start_time;
+
+    std::atomic<const char*> phase{"setup"};
+    std::atomic<long long> current_rest{-1};
+    std::atomic<int> current_missing{-1};
+    std::atomic<long long> moves_tried{0};
+    std::atomic<long long> moves_accepted{0};
+
+    std::mutex stats_mutex;
+    std::map<std::string, double> stats;
+
+    SharedIncumbent incumbent;
+
+    std::thread reporter;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static std::atomic<bool>& dumpRequested() {
+        static std::atomic<bool> requested{false};
+        return requested;
+    }
+
+    static void handleDumpSignal(int) { dumpRequested().store(true); }
+
+    static int& muteDepth() {
+        static thread_local int depth = 0;
+        return depth;
+    }
+
+    static EpochHandle& handle(SharedIncumbent& owner) {
+        static thread_local EpochHandle local(owner.domain());
+        return local;
+    }
+
+    MetricsStream() {
+        if (const char* env = getenv("SOLVER_METRICS")) target = env;
+        if (const char* env = getenv("SOLVER_DUMP_FILE")) dump_file = env;
+        if (const char* env = getenv("SOLVER_METRICS_INTERVAL_MS")) interval_ms = std::max(10, atoi(env));
+        stream_enabled = !target.empty();
+        active_ = stream_enabled || getenv("SOLVER_DUMP_FILE") != nullptr;
+    }
+
+    static int connectSocket(const std::string& spec) {
+        if (spec.rfind("unix:", 0) == 0) {
+            sockaddr_un addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            std::string path = spec.substr(5);
+            if (path.size() >= sizeof(addr.sun_path)) return -1;
+            strcpy(addr.sun_path, path.c_str());
+            int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (sock >= 0 && connect(sock, (sockaddr*)&addr, sizeof(addr)) == 0) return sock;
+            if (sock >= 0) close(sock);
+            return -1;
+        }
+
+        std::string address = spec.substr(4);
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos) return -1;
+        std::string host = colon == 0 ? "127.0.0.1" : address.substr(0, colon);
+        std::string port = address.substr(colon + 1);
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* results = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0) return -1;
+        int sock = -1;
+        for (addrinfo* ai = results; ai && sock < 0; ai = ai->ai_next) {
+            sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (sock >= 0 && connect(sock, ai->ai_addr, ai->ai_addrlen) != 0) {
+                close(sock);
+                sock = -1;
+            }
+        }
+        freeaddrinfo(results);
+        return sock;
+    }
+
+    bool openSink() {
+        if (target.rfind("unix:", 0) == 0 || target.rfind("tcp:", 0) == 0) {
+            fd = connectSocket(target);
+        } else {
+            fd = open(target.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        }
+        if (fd < 0) {
+            std::cerr << "Warning: Cannot open metrics stream " << target << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // 对端断开或写失败时关闭输出，不影响求解
+    void writeLine(const std::string& line) {
+        if (fd < 0) return;
+        size_t done = 0;
+        while (done < line.size()) {
+            ssize_t n = send(fd, line.data() + done, line.size() - done, MSG_NOSIGNAL);
+            if (n < 0 && errno == ENOTSOCK) n = ::write(fd, line.data() + done, line.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                std::cerr << "Warning: Metrics stream " << target << " closed: " << strerror(errno) << std::endl;
+                close(fd);
+                fd = -1;
+                return;
+            }
+            done += n;
+        }
+    }
+
+    static long long residentBytes() {
+        long long pages = 0, resident = 0;
+        FILE* statm = fopen("/proc/self/statm", "r");
+        if (!statm) return -1;
+        if (fscanf(statm, "%lld %lld", &pages, &resident) != 2) resident = -1;
+        fclose(statm);
+        return resident < 0 ? -1 : resident * sysconf(_SC_PAGESIZE);
+    }
+
+    static void writeString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+
+    struct Interval {
+        Clock::time_point time;
+        long long tried = 0;
+        long long accepted = 0;
+    };
+
+    std::string record(const char* event, Interval& last) {
+        Clock::time_point now = Clock::now();
+        long long tried = moves_tried.load(std::memory_order_relaxed);
+        long long accepted = moves_accepted.load(std::memory_order_relaxed);
+        double seconds = std::chrono::duration<double>(now - last.time).count();
+        double rate = seconds > 0 ? (tried - last.tried) / seconds : 0.0;
+        long long interval_tried = tried - last.tried;
+        double acceptance = interval_tried > 0 ? (double)(accepted - last.accepted) / interval_tried : 0.0;
+        last = {now, tried, accepted};
+
+        int64_t best_score = incumbent.bestScore();
+        long long best_rest = -1;
+        int best_missing = -1;
+        if (best_score != NO_INCUMBENT_SCORE) {
+            best_rest = best_score & ((1LL << 40) - 1);
+            best_missing = (int)(best_score >> 40);
+        }
+
+        std::ostringstream out;
+        out << "{\"event\": \"" << event << "\", \"elapsed\": "
+            << std::chrono::duration<double>(now - start_time).count() << ", \"strategy\": ";
+        writeString(out, strategy);
+        out << ", \"phase\": ";
+        writeString(out, phase.load(std::memory_order_relaxed));
+        out << ", \"best_rest_days\": " << best_rest << ", \"best_first14_missing\": " << best_missing
+            << ", \"current_rest_days\": " << current_rest.load(std::memory_order_relaxed)
+            << ", \"current_first14_missing\": " << current_missing.load(std::memory_order_relaxed)
+            << ", \"lower_bound\": " << lower_bound
+            << ", \"bound_gap\": " << (best_rest < 0 ? -1 : best_rest - lower_bound)
+            << ", \"target\": " << rest_target
+            << ", \"target_gap\": " << (best_rest < 0 ? -1 : best_rest - rest_target)
+            << ", \"moves_tried\": " << tried << ", \"moves_accepted\": " << accepted
+            << ", \"moves_per_sec\": " << rate << ", \"acceptance_rate\": " << acceptance
+            << ", \"rss_bytes\": " << residentBytes() << ", \"stats\": {";
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            bool first = true;
+            for (const auto& [name, value] : stats) {
+                out << (first ? "" : ", ");
+                writeString(out, name);
+                out << ": " << value;
+                first = false;
+            }
+        }
+        out << "}}\n";
+        return out.str();
+    }
+
+    // 写到临时文件再改名，读的一方不会看到写了一半的方案
+    bool dumpIncumbent() {
+        CompactSolution best;
+        if (!incumbent.snapshot(handle(incumbent), best)) {
+            std::cerr << "SIGUSR1: no incumbent to dump yet" << std::endl;
+            return false;
+        }
+        std::string temp = dump_file + ".tmp";
+        {
+            std::ofstream file(temp);
+            if (!file.is_open()) {
+                std::cerr << "Warning: Cannot write " << temp << std::endl;
+                return false;
+            }
+            for (int e = 0; e < best.engineers; e++) {
+                for (int i = 0; i < best.slots; i++) file << best.server(e, i) << (i + 1 < best.slots ? " " : "\n");
+            }
+        }
+        if (rename(temp.c_str(), dump_file.c_str()) != 0) return false;
+        std::cerr << "SIGUSR1: dumped incumbent (rest days " << best.rest_days << ") to " << dump_file << std::endl;
+        return true;
+    }
+
+    void run() {
+        Interval last{start_time, 0, 0};
+        Clock::time_point next = start_time + std::chrono::milliseconds(interval_ms);
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        while (!stopping) {
+            // 最多等 50ms 就检查一次 SIGUSR1
+            wake.wait_for(lock, std::chrono::milliseconds(50));
+            if (stopping) break;
+            lock.unlock();
+            if (dumpRequested().exchange(false) && dumpIncumbent() && stream_enabled) {
+                Interval since = last;  // 不打断正常的输出间隔
+                writeLine(record("dump", since));
+            }
+            if (stream_enabled && Clock::now() >= next) {
+                writeLine(record("progress", last));
+                next += std::chrono::milliseconds(interval_ms);
+                if (next < Clock::now()) next = Clock::now() + std::chrono::milliseconds(interval_ms);
+            }
+            lock.lock();
+        }
+        lock.unlock();
+        if (dumpRequested().exchange(false)) dumpIncumbent();
+        if (stream_enabled) writeLine(record("final", last));
+    }
+
+public:
+    // 不析构：线程池的工作线程退出时还会释放各自的 EpochHandle
+    static MetricsStream& instance() {
+        static MetricsStream* stream = new MetricsStream();
+        return *stream;
+    }
+
+    bool active() const { return active_; }
+
+    // day_alarms[d] 为第 d 天报警的服务器数：每天最多这么多工程师工作，
+    // 由此得到总休息天数的下界 sum(max(0, engineers - day_alarms[d]))
+    void start(const std::string& strategy_name, int engineers, const std::vector<int>& day_alarms,
+               long long target_rest_days) {
+        if (!active_ || reporter.joinable()) return;
+        strategy = strategy_name;
+        rest_target = target_rest_days;
+        lower_bound = 0;
+        for (int alarms : day_alarms) lower_bound += std::max(0, engineers - alarms);
+        start_time = Clock::now();
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = handleDumpSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &action, nullptr);
+
+        if (stream_enabled && !openSink()) stream_enabled = false;
+        reporter = std::thread([this]() { run(); });
+    }
+
+    // 写出最后一行并停止输出线程
+    void stop() {
+        if (!reporter.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        reporter.join();
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+
+    void setPhase(const char* name) {
+        if (active_ && muteDepth() == 0) phase.store(name, std::memory_order_relaxed);
+    }
+
+    void setStat(const std::string& name, double value) {
+        if (!active_ || muteDepth() > 0) return;
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats[name] = value;
+    }
+
+    void addMoves(long long tried, long long accepted) {
+        if (!active_) return;
+        moves_tried.fetch_add(tried, std::memory_order_relaxed);
+        moves_accepted.fetch_add(accepted, std::memory_order_relaxed);
+    }
+
+    void reportCurrent(long long rest_days, int first14_missing) {
+        if (!active_ || muteDepth() > 0) return;
+        current_rest.store(rest_days, std::memory_order_relaxed);
+        current_missing.store(first14_missing, std::memory_order_relaxed);
+    }
+
+    // 比当前最优严格更好时才拷贝
+    void offerIncumbent(const AllocationState& state) {
+        if (!active_ || muteDepth() > 0) return;
+        reportCurrent(state.total_rest_days, state.first14_missing);
+        if (!incumbent.improves(incumbentScore(state.first14_missing, state.total_rest_days))) return;
+        auto compact = std::make_unique<CompactSolution>();
+        compact->engineers = state.engineers;
+        compact->slots = state.slots;
+        compact->rest_days = state.total_rest_days;
+        compact->first14_missing = state.first14_missing;
+        compact->slot_server = state.slot_server;
+        incumbent.publish(handle(incumbent), std::move(compact));
+    }
+
+    void offerIncumbent(const CompactSolution& solution) {
+        if (!active_ || muteDepth() > 0) return;
+        reportCurrent(solution.rest_days, solution.first14_missing);
+        if (!incumbent.improves(solution.score())) return;
+        incumbent.publish(handle(incumbent), std::make_unique<CompactSolution>(solution));
+    }
+
+    friend class MetricsMute;
+};
+
+inline MetricsStream& metricsStream() {
+    return MetricsStream::instance();
+}
+
+// 作用域内当前线程不报告当前值和方案（分解求解的子问题）
+class MetricsMute {
+public:
+    MetricsMute() { MetricsStream::muteDepth()++; }
+    ~MetricsMute() { MetricsStream::muteDepth()--; }
+    MetricsMute(const MetricsMute&) = delete;
+    MetricsMute& operator=(const MetricsMute&) = delete;
+};
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef NEIGHBOR_LISTS_H
+#define NEIGHBOR_LISTS_H
+
+// 基于 MinHash/LSH 的互补邻居表，用于服务器数量很大（10^5 ~ 10^6）的实例。
+//
+// 服务器 b 是服务器 a 的互补邻居：b 的报警天与 a 的空闲天（a 掩码的补集）相似，
+// 和 a 放在同一个工程师手里能填上 a 没覆盖的天。对每台服务器的掩码和掩码补集各算
+// bands * rows 个 MinHash，按 band 分桶：同一个桶里 "a 的补集" 和 "b 的掩码" 相遇
+// 就把 b 作为 a 的候选，用实际收益 popcount(b & ~a) 打分，每台服务器保留前 per_server 个。
+//
+// 每次只处理一个 band，桶内最多取 bucket_cap 个成员配对（桶内顺序按哈希打乱，
+// 不同 band 取到不同的子集），所以预处理是 O(n * bands * (log n + bucket_cap))，
+// 内存是邻居表 n * per_server 加一个 band 的临时数组。MinHash 计算和桶的配对都按
+// 线程切分：每台服务器在一个 band 里只作为查询出现一次，不同线程不会写同一张表。
+//
+// 局部搜索不再枚举所有服务器，而是从工程师现有服务器的邻居里取候选。
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+#include "allocation_state.h"
+#include "task_pool.h"
+
+struct NeighborListConfig {
+    int bands = 8;          // LSH band 数，越多召回越高
+    int rows = 2;           // 每个 band 的 MinHash 个数，越多桶越精确
+    int per_server = 16;    // 每台服务器保留的邻居数
+    int bucket_cap = 64;    // 每个桶最多参与配对的成员数
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+};
+
+// 服务器数量达到这个规模时，局部搜索改用邻居表取候选
+const int NEIGHBOR_LIST_MIN_SERVERS = 100000;
+
+class NeighborLists {
+private:
+    struct BandEntry {
+        uint64_t key;
+        uint32_t order;   // 桶内的随机顺序
+        int32_t server;
+        uint8_t query;    // 1 = 服务器掩码的补集（查询），0 = 服务器掩码（成员）
+    };
+
+    int per_server = 0;
+    std::vector<int32_t> neighbors;  // neighbors[s * per_server + k]
+    std::vector<uint8_t> gains;      // 与 neighbors 对应的收益
+    std::vector<uint8_t> counts;     // counts[s] = 已有的邻居数
+
+    static uint64_t mix(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    template <typename Body>
+    static void parallelFor(int threads, size_t n, Body body) {
+        threads = std::max(1, std::min<int>(threads, (int)std::max<size_t>(1, n / 1024)));
+        solverPool().parallelChunks(n, threads, [&](int, size_t lo, size_t hi) { body(lo, hi); });
+    }
+
+    void offer(int a, int b, int gain) {
+        int32_t* list = &neighbors[(size_t)a * per_server];
+        uint8_t* score = &gains[(size_t)a * per_server];
+        int n = counts[a];
+        int worst = -1;
+        for (int k = 0; k < n; k++) {
+            if (list[k] == b) return;
+            if (worst == -1 || score[k] < score[worst]) worst = k;
+        }
+        if (n < per_server) {
+            list[n] = b;
+            score[n] = (uint8_t)gain;
+            counts[a]++;
+        } else if (gain > score[worst]) {
+            list[worst] = b;
+            score[worst] = (uint8_t)gain;
+        }
+    }
+
+public:
+    // deadline 之后不再处理剩下的 band：已经处理的 band 得到的邻居仍然有效，只是候选少一些
+    void build(const AllocationState& state, int threads, const NeighborListConfig& config = NeighborListConfig(),
+               std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+        const int n = state.servers;
+        const int hashes = config.bands * config.rows;
+        per_server = config.per_server;
+        neighbors.assign((size_t)n * per_server, -1);
+        gains.assign((size_t)n * per_server, 0);
+        counts.assign(n, 0);
+
+        std::vector<uint64_t> masks(n);
+        for (int s = 0; s < n; s++) masks[s] = state.serverMask(s);
+
+        // 每个哈希函数给每一天一个随机值，集合的 MinHash 是其中所有天的最小值
+        std::vector<uint64_t> day_hash((size_t)hashes * 64);
+        for (size_t k = 0; k < day_hash.size(); k++) day_hash[k] = mix(config.seed + k * 0x9E3779B97F4A7C15ULL);
+
+        auto bandKey = [&](uint64_t mask, int band) {
+            uint64_t key = mix(config.seed ^ (uint64_t)band);
+            for (int r = 0; r < config.rows; r++) {
+                const uint64_t* h = &day_hash[(size_t)(band * config.rows + r) * 64];
+                uint64_t lowest = ~0ULL;
+                for (uint64_t m = mask; m; m &= m - 1) lowest = std::min(lowest, h[__builtin_ctzll(m)]);
+                key = mix(key ^ lowest);
+            }
+            return key;
+        };
+
+        std::vector<BandEntry> entries((size_t)n * 2);
+        std::vector<size_t> bucket_start;
+        for (int band = 0; band < config.bands; band++) {
+            if (std::chrono::steady_clock::now() >= deadline) break;
+            parallelFor(threads, n, [&](size_t lo, size_t hi) {
+                for (size_t s = lo; s < hi; s++) {
+                    uint64_t mask = masks[s];
+                    uint64_t gaps = ~mask & state.horizon_mask;
+                    uint32_t order = (uint32_t)mix(((uint64_t)band << 32) ^ s);
+                    // 没有报警的服务器不当成员，全天报警的服务器没有空闲天可以查询
+                    entries[2 * s] = {mask ? bandKey(mask, band) : 0, order, (int32_t)s, 0};
+                    entries[2 * s + 1] = {gaps ? bandKey(gaps, band) : 0, order, (int32_t)s, 1};
+                    if (!mask) entries[2 * s].server = -1;
+                    if (!gaps) entries[2 * s + 1].server = -1;
+                }
+            });
+
+            std::sort(entries.begin(), entries.end(), [](const BandEntry& a, const BandEntry& b) {
+                if (a.key != b.key) return a.key < b.key;
+                if (a.query != b.query) return a.query < b.query;
+                return a.order < b.order;
+            });
+
+            bucket_start.clear();
+            for (size_t k = 0; k < entries.size(); k++) {
+                if (k == 0 || entries[k].key != entries[k - 1].key) bucket_start.push_back(k);
+            }
+            bucket_start.push_back(entries.size());
+
+            // 桶内成员（query = 0）排在查询之前
+            parallelFor(threads, bucket_start.size() - 1, [&](size_t lo, size_t hi) {
+                for (size_t b = lo; b < hi; b++) {
+                    size_t begin = bucket_start[b], end = bucket_start[b + 1];
+                    size_t members_end = begin;
+                    while (members_end < end && !entries[members_end].query) members_end++;
+                    size_t cap_end = std::min(members_end, begin + (size_t)config.bucket_cap);
+
+                    for (size_t q = members_end; q < end; q++) {
+                        int a = entries[q].server;
+                        if (a == -1) continue;
+                        uint64_t gaps = ~masks[a] & state.horizon_mask;
+                        for (size_t m = begin; m < cap_end; m++) {
+                            int candidate = entries[m].server;
+                            if (candidate == -1 || candidate == a) continue;
+                            int gain = __builtin_popcountll(masks[candidate] & gaps);
+                            if (gain > 0) offer(a, candidate, gain);
+                        }
+                    }
+                }
+            });
+        }
+
+        // 每张表按收益降序
+        parallelFor(threads, n, [&](size_t lo, size_t hi) {
+            std::vector<std::pair<int, int>> sorted;
+            for (size_t s = lo; s < hi; s++) {
+                sorted.clear();
+                for (int k = 0; k < counts[s]; k++) {
+                    sorted.push_back({gains[s * per_server + k], neighbors[s * per_server + k]});
+                }
+                std::sort(sorted.begin(), sorted.end(), [](const std::pair<int, int>& x, const std::pair<int, int>& y) {
+                    return x.first != y.first ? x.first > y.first : x.second < y.second;
+                });
+                for (int k = 0; k < counts[s]; k++) {
+                    gains[s * per_server + k] = (uint8_t)sorted[k].first;
+                    neighbors[s * per_server + k] = sorted[k].second;
+                }
+            }
+        });
+    }
+
+    bool empty() const { return neighbors.empty(); }
+    const int32_t* begin(int server) const { return &neighbors[(size_t)server * per_server]; }
+    const int32_t* end(int server) const { return begin(server) + counts[server]; }
+
+    // 工程师 e 的候选：它现有服务器的互补邻居（去重）
+    void sample(const AllocationState& state, int e, std::vector<int>& out) const {
+        out.clear();
+        for (int i = 0; i < state.slots; i++) {
+            int server = state.slotServer(e, i);
+            if (server == -1) continue;
+            out.insert(out.end(), begin(server), end(server));
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    size_t memoryBytes() const {
+        return neighbors.size() * sizeof(int32_t) + gains.size() + counts.size();
+    }
+};
+
+#endif
@@ -0,0 +1,407 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "allocation_state.h"
+#include "local_search.h"
+
+using namespace std;
+
+// 在线模式：逐天读入警报行（标准输入或 FIFO），增量更新服务器掩码和工程师工作掩码，
+// 每天只围绕当天触发的服务器做有时间上限的修复，然后输出更新后的分配和休息天数。
+// 前14天结束后，还没有前14天工作的工程师也在每天的时间上限内修复，修不完的留到下一天。
+// 每天的更新代价与当天的警报数量成正比，与已经读入的历史天数无关：扩展一天不碰工程师，
+// 修复用的未分配服务器列表增量维护，输出文件只改写当天有变化的工程师所在的行。
+
+const int DEFAULT_ENGINEERS = 336;
+const int DEFAULT_SERVERS = 1620;
+const int DEFAULT_SLOTS = 5;
+const int FIRST_14_DAYS = 14;
+const int MAX_DAYS = 64;
+
+struct OnlineConfig {
+    int engineers = DEFAULT_ENGINEERS;
+    int servers = DEFAULT_SERVERS;
+    int slots = DEFAULT_SLOTS;
+    string input = "-";
+    string output = "online_solution.txt";
+    string initial;
+    int candidates = 256;    // 每台触发服务器最多评估的工程师数量
+    double budget_ms = 50.0; // 每天修复的时间上限
+};
+
+struct DayReport {
+    int alarms = 0;
+    int ignored = 0;
+    int placed = 0;
+    int moves = 0;
+    double millis = 0.0;
+};
+
+class OnlineAllocationSolver {
+private:
+    OnlineConfig config;
+    vector<uint64_t> server_masks;
+    AllocationState state;
+    int num_days = 0;
+    int cursor = 0;                 // 候选工程师窗口的起点，每台服务器轮转
+    vector<int> touched;            // 当天工作或分配有变化的工程师（触发服务器的负责人、接手服务器的和修复改动的工程师）
+    vector<uint8_t> touched_mark;
+    vector<int> unassigned;         // 覆盖前14天的未分配服务器，可能含已经分配出去的或重复的，修复前压缩
+    vector<uint8_t> pooled;
+    int field_width = 0;            // 输出文件定宽：每行长度相同，之后按行原地改写
+    bool written = false;
+
+public:
+    explicit OnlineAllocationSolver(const OnlineConfig& cfg)
+        : config(cfg), server_masks(cfg.servers, 0), touched_mark(cfg.engineers, 0), pooled(cfg.servers, 0) {
+        state.reset(server_masks.data(), config.servers, (1ULL << FIRST_14_DAYS) - 1,
+                    config.engineers, config.servers, config.slots, 0);
+        field_width = max<int>(2, to_string(config.servers - 1).size());
+    }
+
+    bool loadInitial(const string& filename) {
+        vector<vector<int>> allocation;
+        if (!loadAllocationFile(filename, config.slots, allocation)) return false;
+        RepairReport report = state.assignFrom(allocation);
+        cout << "Initial allocation: dropped " << report.out_of_range << " out-of-range, "
+             << report.duplicates << " duplicate, " << report.overflow << " overflow servers" << endl;
+        return true;
+    }
+
+    int days() const { return num_days; }
+    const AllocationState& allocation() const { return state; }
+    const vector<int>& touchedEngineers() const { return touched; }
+
+    DayReport ingestDay(const vector<long long>& alarms) {
+        auto start = chrono::steady_clock::now();
+        DayReport report;
+
+        for (int e : touched) touched_mark[e] = 0;
+        touched.clear();
+
+        int day = num_days++;
+        uint64_t bit = 1ULL << day;
+        state.extendHorizon(num_days);
+
+        // 增量更新：只处理当天触发的服务器
+        vector<int> fired;
+        fired.reserve(alarms.size());
+        for (long long server : alarms) {
+            if (server < 0 || server >= config.servers) {
+                report.ignored++;
+                continue;
+            }
+            if (server_masks[server] & bit) continue;
+            server_masks[server] |= bit;
+            state.addAlarm(server, bit);
+            fired.push_back(server);
+            touch(state.owner[server]);
+            if (day < FIRST_14_DAYS) offerUnassigned(server);
+        }
+        report.alarms = fired.size();
+
+        // 有时间上限的修复：每台触发的服务器尝试放给当天休息的工程师
+        double budget = config.budget_ms / 1000.0;
+        for (size_t k = 0; k < fired.size(); k++) {
+            if ((k & 63) == 0 && chrono::duration<double>(chrono::steady_clock::now() - start).count() > budget) {
+                break;
+            }
+            int server = fired[k];
+            if (state.owner[server] == -1) {
+                if (placeServer(server, day)) report.placed++;
+            } else if (moveServer(server, day)) {
+                report.moves++;
+            }
+        }
+
+        // 前14天结束后仍然没有前14天工作的工程师在当天剩余的预算内修复
+        if (day >= FIRST_14_DAYS - 1 && state.first14_missing > 0) {
+            auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                                        chrono::duration<double, milli>(config.budget_ms));
+            compactUnassigned();
+            // 修复改动的工程师从撤销日志里取，换下来的服务器由 repairFirst14 追加到列表里
+            size_t mark = state.checkpoint();
+            report.moves += repairFirst14(state, nullptr, deadline, &unassigned);
+            vector<int> engineers, servers;
+            state.changedSince(mark, engineers, servers);
+            state.commit();
+            for (int e : engineers) touch(e);
+        }
+
+        report.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+    // 第一次整体写出（临时文件加 rename），之后只原地改写当天有变化的工程师那几行。
+    // 原地改写不是原子的，读者可能看到当天只更新了一部分的文件
+    void saveSolution(const string& filename) {
+        if (written) {
+            fstream file(filename, ios::in | ios::out | ios::binary);
+            if (file.is_open()) {
+                for (int e : touched) {
+                    file.seekp((streamoff)e * rowLength());
+                    file << formatRow(e);
+                }
+                if (file) return;
+            }
+        }
+
+        string tmp = filename + ".tmp";
+        ofstream file(tmp, ios::binary);
+        if (!file.is_open()) {
+            cerr << "Error: Cannot create " << filename << endl;
+            return;
+        }
+        for (int e = 0; e < config.engineers; e++) file << formatRow(e);
+        file.close();
+        written = rename(tmp.c_str(), filename.c_str()) == 0;
+    }
+
+private:
+    void touch(int e) {
+        if (e == -1 || touched_mark[e]) return;
+        touched_mark[e] = 1;
+        touched.push_back(e);
+    }
+
+    void offerUnassigned(int server) {
+        if (server == -1 || pooled[server] || state.owner[server] != -1) return;
+        if (!(state.serverMask(server) & state.first14_mask)) return;
+        pooled[server] = 1;
+        unassigned.push_back(server);
+    }
+
+    // 去掉已经分配出去的和重复的，代价与列表长度成正比
+    void compactUnassigned() {
+        for (int s : unassigned) pooled[s] = 0;
+        size_t kept = 0;
+        for (int s : unassigned) {
+            if (pooled[s] || state.owner[s] != -1) continue;
+            pooled[s] = 1;
+            unassigned[kept++] = s;
+        }
+        unassigned.resize(kept);
+    }
+
+    size_t rowLength() const { return (size_t)config.slots * (field_width + 1); }
+
+    string formatRow(int e) const {
+        string row;
+        char field[16];
+        for (int i = 0; i < config.slots; i++) {
+            snprintf(field, sizeof(field), "%*d", field_width, state.slotServer(e, i));
+            row += field;
+            row += i < config.slots - 1 ? ' ' : '\n';
+        }
+        return row;
+    }
+
+    // 前14天内，让还没有前14天工作的工程师优先拿到服务器
+    int gainFor(int e, uint64_t new_mask, int day) const {
+        int gain = __builtin_popcountll(new_mask) - state.workDays(e);
+        if (day < FIRST_14_DAYS && !state.hasFirst14(e) && (new_mask & state.first14_mask)) {
+            gain += MAX_DAYS;
+        }
+        return gain;
+    }
+
+    bool keepsFirst14(int e, uint64_t new_mask) const {
+        return !state.hasFirst14(e) || (new_mask & state.first14_mask);
+    }
+
+    bool placeServer(int server, int day) {
+        uint64_t mask = state.serverMask(server);
+        uint64_t bit = 1ULL << day;
+        int window = min(config.candidates, config.engineers);
+
+        int best_gain = 0, best_e = -1, best_slot = -1;
+        for (int t = 0; t < window; t++) {
+            int e = (cursor + t) % config.engineers;
+            if (state.work_mask[e] & bit) continue;
+
+            for (int i = 0; i < config.slots; i++) {
+                int current = state.slotServer(e, i);
+                uint64_t new_mask = state.maskWithout(e, i) | mask;
+                if (current != -1 && !keepsFirst14(e, new_mask)) continue;
+                int gain = gainFor(e, new_mask, day);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_e = e;
+                    best_slot = i;
+                }
+                if (current == -1) break;
+            }
+        }
+        cursor = (cursor + window) % config.engineers;
+
+        if (best_e == -1) return false;
+        int removed = state.slotServer(best_e, best_slot);
+        state.replace(best_e, best_slot, server);
+        touch(best_e);
+        offerUnassigned(removed);
+        return true;
+    }
+
+    // 把已分配的服务器换给当天休息的工程师（对方的一个槽位换回来，可以为空）
+    bool moveServer(int server, int day) {
+        int e = state.owner[server];
+        int i = state.slotOf(e, server);
+        uint64_t mask = state.serverMask(server);
+        uint64_t bit = 1ULL << day;
+        uint64_t rest_e = state.maskWithout(e, i);
+        int window = min(config.candidates, config.engineers);
+
+        int best_delta = 0, best_d = -1, best_j = -1;
+        for (int t = 0; t < window; t++) {
+            int d = (cursor + t) % config.engineers;
+            if (d == e || (state.work_mask[d] & bit)) continue;
+
+            for (int j = 0; j < config.slots; j++) {
+                int other = state.slotServer(d, j);
+                uint64_t new_e = rest_e | (other == -1 ? 0 : state.serverMask(other));
+                uint64_t new_d = state.maskWithout(d, j) | mask;
+                if (!keepsFirst14(e, new_e) || !keepsFirst14(d, new_d)) continue;
+
+                int delta = gainFor(e, new_e, day) + gainFor(d, new_d, day);
+                if (delta > best_delta) {
+                    best_delta = delta;
+                    best_d = d;
+                    best_j = j;
+                }
+            }
+        }
+        cursor = (cursor + window) % config.engineers;
+
+        if (best_d == -1) return false;
+        state.exchange(e, i, best_d, best_j);
+        touch(best_d);
+        return true;
+    }
+};
+
+static bool parseAlarmLine(const string& line, vector<long long>& alarms) {
+    alarms.clear();
+    const char* p = line.c_str();
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+        if (!*p) break;
+        char* end;
+        long long server = strtoll(p, &end, 10);
+        if (end == p) return false;
+        alarms.push_back(server);
+        p = end;
+    }
+    return true;
+}
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << "  --input FILE         警报输入，每行一天，- 表示标准输入 (默认 -)" << endl;
+    cout << "  --out FILE           每天更新后的分配方案 (默认 online_solution.txt)" << endl;
+    cout << "  --initial FILE       初始分配方案 (默认为空)" << endl;
+    cout << "  --engineers N        工程师数量 (默认 " << DEFAULT_ENGINEERS << ")" << endl;
+    cout << "  --servers N          服务器数量 (默认 " << DEFAULT_SERVERS << ")" << endl;
+    cout << "  --slots N            每个工程师最多负责的服务器 (默认 " << DEFAULT_SLOTS << ")" << endl;
+    cout << "  --candidates N       每台服务器评估的工程师数量 (默认 256)" << endl;
+    cout << "  --budget-ms MS       每天修复的时间上限 (默认 50)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    OnlineConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--input") config.input = value;
+        else if (arg == "--out") config.output = value;
+        else if (arg == "--initial") config.initial = value;
+        else if (arg == "--engineers") config.engineers = stoi(value);
+        else if (arg == "--servers") config.servers = stoi(value);
+        else if (arg == "--slots") config.slots = stoi(value);
+        else if (arg == "--candidates") config.candidates = stoi(value);
+        else if (arg == "--budget-ms") config.budget_ms = stod(value);
+        else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (config.engineers <= 0 || config.servers <= 0 || config.slots <= 0 || config.candidates <= 0) {
+        cerr << "Error: engineers, servers, slots and candidates must be positive" << endl;
+        return 1;
+    }
+
+    ifstream file;
+    if (config.input != "-") {
+        file.open(config.input);
+        if (!file.is_open()) {
+            cerr << "Error: Cannot open " << config.input << endl;
+            return 1;
+        }
+    }
+    istream& in = config.input == "-" ? cin : file;
+
+    cout << "=== Online Allocation Solver ===" << endl;
+    cout << "Engineers: " << config.engineers << endl;
+    cout << "Servers: " << config.servers << endl;
+    cout << "Max servers per engineer: " << config.slots << endl;
+
+    OnlineAllocationSolver solver(config);
+    if (!config.initial.empty() && !solver.loadInitial(config.initial)) {
+        return 1;
+    }
+
+    string line;
+    vector<long long> alarms;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (!parseAlarmLine(line, alarms)) {
+            cerr << "Warning: skipping malformed line: " << line << endl;
+            continue;
+        }
+        if (solver.days() >= MAX_DAYS) {
+            cerr << "Error: at most " << MAX_DAYS << " days are supported" << endl;
+            return 1;
+        }
+
+        DayReport report = solver.ingestDay(alarms);
+        const AllocationState& state = solver.allocation();
+
+        cout << "Day " << solver.days() - 1 << ": " << report.alarms << " alarms";
+        if (report.ignored > 0) cout << " (" << report.ignored << " ignored)";
+        cout << ", placed " << report.placed << ", moves " << report.moves
+             << ", rest days " << state.total_rest_days
+             << ", without first 14 days work " << state.first14_missing
+             << ", update " << report.millis << " ms"
+             << ", engineers with changed work/assignment " << solver.touchedEngineers().size() << endl;
+
+        // 只输出当天工作或分配有变化的工程师
+        for (int e : solver.touchedEngineers()) {
+            cout << "  Engineer " << e << ": rest " << state.restDays(e) << ", servers";
+            for (int i = 0; i < state.slots; i++) cout << " " << state.slotServer(e, i);
+            cout << endl;
+        }
+
+        solver.saveSolution(config.output);
+    }
+
+    cout << "\nFinal rest days over " << solver.days() << " days: " << solver.allocation().total_rest_days << endl;
+    cout << "Solution saved to " << config.output << endl;
+    return 0;
+}
@@ -0,0 +1,300 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// 求解内核的硬件性能计数器（Linux perf_event_open），不需要外部 profiler。
+//
+// 设置环境变量 SOLVER_PERF=1 打开。主要内核用 PerfScope 包起来：
+//   parse        警报文本解析
+//   index_build  天掩码、掩码类、候选顺序、按天的服务器表
+//   gain_scan    贪心的增益内核（bestServerGain / coverageGains）
+//   delta_eval   局部搜索的移动评估（批量扫描的评估线程、首次改进搜索的每一轮）
+//   validation   按警报数据重新计算每日工作和约束
+// 每个线程第一次进入时打开自己的一组计数器（cycles、instructions、cache references、
+// cache misses、branch misses，只计用户态），进出作用域各读一次，差值累加到内核的合计上。
+// 结束时 printPerfSummary 输出每个内核的 IPC、缓存缺失率和每千条指令的缺失数：
+// IPC 低且缺失多说明是访存瓶颈，IPC 高说明是计算瓶颈。
+//
+// 计数器打不开（容器或虚拟机里常见）时只统计调用次数和时间，并在汇总中说明原因。
+// 每次进出作用域是两次 read 系统调用，只适合诊断；关闭时每个埋点只是一次布尔判断。
+// 作用域嵌套时外层的计数包含内层；同一作用域里分段计数用 stop()。
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum PerfKernel {
+    PERF_PARSE = 0,
+    PERF_INDEX_BUILD,
+    PERF_GAIN_SCAN,
+    PERF_DELTA_EVAL,
+    PERF_VALIDATION,
+    PERF_KERNELS
+};
+
+enum PerfEvent {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_REFERENCES,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENTS
+};
+
+inline const char* perfKernelName(int kernel) {
+    static const char* names[PERF_KERNELS] = {"parse", "index_build", "gain_scan", "delta_eval", "validation"};
+    return names[kernel];
+}
+
+// 原始计数和组的 time_enabled / time_running；两次读数先相减再按区间内的比例放大，
+// 各自放大后的值在多路复用时不单调，相减可能为负
+struct PerfReading {
+    uint64_t values[PERF_EVENTS] = {};
+    bool present[PERF_EVENTS] = {};
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+};
+
+// 一个线程的计数器组：cycles 是组长，其他事件打不开时跳过
+class PerfCounterGroup {
+private:
+    int fds[PERF_EVENTS];
+    int order[PERF_EVENTS];   // 组读出的第 k 个值对应的事件
+    int opened = 0;
+    int error = 0;
+
+public:
+    PerfCounterGroup() {
+        for (int i = 0; i < PERF_EVENTS; i++) fds[i] = -1;
+#ifdef __linux__
+        static const uint64_t configs[PERF_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+            if (fd < 0) {
+                if (i == 0) {
+                    error = errno;
+                    return;
+                }
+                continue;
+            }
+            fds[i] = fd;
+            order[opened++] = i;
+        }
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+        error = ENOSYS;
+#endif
+    }
+
+    ~PerfCounterGroup() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const { return opened > 0; }
+    int openError() const { return error; }
+
+    // 读原始计数，不做多路复用的放大（由 PerfCounters::add 对差值放大）
+    bool read(PerfReading& reading) const {
+#ifdef __linux__
+        if (!available()) return false;
+        uint64_t buffer[3 + PERF_EVENTS];
+        if (::read(fds[0], buffer, sizeof(buffer)) < (ssize_t)(3 * sizeof(uint64_t))) return false;
+        reading.time_enabled = buffer[1];
+        reading.time_running = buffer[2];
+        for (uint64_t k = 0; k < buffer[0] && k < (uint64_t)opened; k++) {
+            reading.values[order[k]] = buffer[3 + k];
+            reading.present[order[k]] = true;
+        }
+        return true;
+#else
+        (void)reading;
+        return false;
+#endif
+    }
+};
+
+class PerfCounters {
+private:
+    struct alignas(64) KernelTotals {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> nanoseconds{0};
+        std::atomic<uint64_t> values[PERF_EVENTS];
+        std::atomic<bool> present[PERF_EVENTS];
+        KernelTotals() {
+            for (int i = 0; i < PERF_EVENTS; i++) {
+                values[i] = 0;
+                present[i] = false;
+            }
+        }
+    };
+
+    bool enabled_ = false;
+    KernelTotals totals[PERF_KERNELS];
+    std::atomic<int> open_error{0};
+
+    PerfCounters() {
+        const char* env = getenv("SOLVER_PERF");
+        enabled_ = env && atoi(env) != 0;
+    }
+
+public:
+    static PerfCounters& instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    bool enabled() const { return enabled_; }
+
+    // 当前线程的计数器组，第一次使用时打开
+    PerfCounterGroup& group() {
+        static thread_local PerfCounterGroup local;
+        if (!local.available() && local.openError()) open_error.store(local.openError(), std::memory_order_relaxed);
+        return local;
+    }
+
+    void add(int kernel, uint64_t nanoseconds, const PerfReading& before, const PerfReading& after, bool counted) {
+        KernelTotals& t = totals[kernel];
+        t.calls.fetch_add(1, std::memory_order_relaxed);
+        t.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        if (!counted) return;
+
+        // 组在这段时间里只有 running / enabled 的时间在计数（多路复用），差值按这个比例放大；
+        // 完全没有被调度上的区间没有可用的计数
+        uint64_t enabled = after.time_enabled - before.time_enabled;
+        uint64_t running = after.time_running - before.time_running;
+        if (after.time_enabled < before.time_enabled || after.time_running < before.time_running ||
+            (running == 0 && enabled > 0)) {
+            return;
+        }
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            if (!before.present[i] || !after.present[i] || after.values[i] < before.values[i]) continue;
+            uint64_t delta = after.values[i] - before.values[i];
+            if (running > 0 && running < enabled) delta = (uint64_t)((double)delta * enabled / running);
+            t.values[i].fetch_add(delta, std::memory_order_relaxed);
+            t.present[i].store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void printSummary() const {
+        std::cout << "\n=== Kernel Performance Counters ===" << std::endl;
+        if (int error = open_error.load(std::memory_order_relaxed)) {
+            std::cout << "Hardware counters unavailable (" << strerror(error)
+                      << "), reporting calls and time only" << std::endl;
+        }
+        std::cout << std::left << std::setw(13) << "kernel" << std::right << std::setw(10) << "calls"
+                  << std::setw(11) << "ms" << std::setw(13) << "Mcycles" << std::setw(13) << "Minstr"
+                  << std::setw(7) << "IPC" << std::setw(10) << "miss%" << std::setw(8) << "MPKI"
+                  << std::setw(9) << "BrMPKI" << std::endl;
+
+        auto per_kilo = [](uint64_t count, uint64_t instructions) {
+            return instructions ? 1000.0 * count / instructions : 0.0;
+        };
+        for (int k = 0; k < PERF_KERNELS; k++) {
+            const KernelTotals& t = totals[k];
+            uint64_t calls = t.calls.load(std::memory_order_relaxed);
+            if (calls == 0) continue;
+            uint64_t v[PERF_EVENTS];
+            bool has[PERF_EVENTS];
+            for (int i = 0; i < PERF_EVENTS; i++) {
+                v[i] = t.values[i].load(std::memory_order_relaxed);
+                has[i] = t.present[i].load(std::memory_order_relaxed);
+            }
+
+            std::cout << std::left << std::setw(13) << perfKernelName(k) << std::right << std::setw(10) << calls
+                      << std::setw(11) << std::fixed << std::setprecision(2)
+                      << t.nanoseconds.load(std::memory_order_relaxed) / 1e6;
+            auto column = [&](bool shown, double value, int width) {
+                if (shown) {
+                    std::cout << std::setw(width) << value;
+                } else {
+                    std::cout << std::setw(width) << "-";
+                }
+            };
+            column(has[PERF_CYCLES], v[PERF_CYCLES] / 1e6, 13);
+            column(has[PERF_INSTRUCTIONS], v[PERF_INSTRUCTIONS] / 1e6, 13);
+            column(has[PERF_CYCLES] && has[PERF_INSTRUCTIONS] && v[PERF_CYCLES],
+                   v[PERF_CYCLES] ? (double)v[PERF_INSTRUCTIONS] / v[PERF_CYCLES] : 0.0, 7);
+            column(has[PERF_CACHE_REFERENCES] && has[PERF_CACHE_MISSES] && v[PERF_CACHE_REFERENCES],
+                   v[PERF_CACHE_REFERENCES] ? 100.0 * v[PERF_CACHE_MISSES] / v[PERF_CACHE_REFERENCES] : 0.0, 10);
+            column(has[PERF_CACHE_MISSES] && has[PERF_INSTRUCTIONS],
+                   per_kilo(v[PERF_CACHE_MISSES], v[PERF_INSTRUCTIONS]), 8);
+            column(has[PERF_BRANCH_MISSES] && has[PERF_INSTRUCTIONS],
+                   per_kilo(v[PERF_BRANCH_MISSES], v[PERF_INSTRUCTIONS]), 9);
+            std::cout << std::defaultfloat << std::endl;
+        }
+    }
+};
+
+inline bool perfEnabled() {
+    return PerfCounters::instance().enabled();
+}
+
+// 未打开时什么都不输出
+inline void printPerfSummary() {
+    if (perfEnabled()) PerfCounters::instance().printSummary();
+}
+
+class PerfScope {
+private:
+    int kernel;
+    bool active;
+    bool counted = false;
+    PerfReading before;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit PerfScope(PerfKernel perf_kernel) : kernel(perf_kernel), active(perfEnabled()) {
+        if (!active) return;
+        counted = PerfCounters::instance().group().read(before);
+        start = std::chrono::steady_clock::now();
+    }
+    ~PerfScope() { stop(); }
+
+    // 提前结束计数（之后析构不再重复累加）
+    void stop() {
+        if (!active) return;
+        active = false;
+        auto end = std::chrono::steady_clock::now();
+        PerfCounters& counters = PerfCounters::instance();
+        PerfReading after;
+        if (counted) counted = counters.group().read(after);
+        counters.add(kernel, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), before, after,
+                     counted);
+    }
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+};
+
+#endif
@@ -8,57 +8,26 @@
 #include <sstream>
 #include <queue>
 #include <cmath>
+#include <chrono>
 
-using namespace std;
-
-const int NUM_ENGINEERS = 336;
-const int NUM_SERVERS = 1620;
-const int MAX_SERVERS_PER_ENGINEER = 5;
-const int NUM_DAYS = 22;
-const int MAX_REST_DAYS = 410;
+#include "solver_strategy.h"
+#include "day_mask.h"
+#include "alloc_counter.h"
 
-struct Solution {
-    vector<vector<int>> allocation;
-    vector<vector<bool>> daily_work;
-    int total_rest_days;
-    bool valid;
-    
-    Solution() : allocation(NUM_ENGINEERS, vector<int>(MAX_SERVERS_PER_ENGINEER, -1)), 
-                 daily_work(NUM_ENGINEERS, vector<bool>(NUM_DAYS, false)), 
-                 total_rest_days(0), valid(false) {}
-};
+using namespace std;
 
-class PreciseILPSolver {
+class PreciseILPSolver : public SolverStrategy {
 private:
-    vector<vector<int>> daily_alarms;
-    map<int, set<int>> server_to_days;
+    const ProblemData& data;
+    const map<int, vector<int>>& server_to_days;
+    const int num_days;
+    vector<DayMask<1>> server_masks;             // 候选评估用的天掩码，评估过程不做堆分配
     vector<pair<double, int>> server_efficiency; // (efficiency_score, server_id)
     
 public:
-    bool loadAlarmData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot open " << filename << endl;
-            return false;
-        }
-        
-        daily_alarms.resize(NUM_DAYS);
-        string line;
-        int day = 0;
-        
-        while (getline(file, line) && day < NUM_DAYS) {
-            if (line.empty() || !isdigit(line[0])) continue;
-            
-            istringstream iss(line);
-            int server;
-            while (iss >> server) {
-                daily_alarms[day].push_back(server);
-                server_to_days[server].insert(day);
-            }
-            day++;
-        }
-        
-        file.close();
+    explicit PreciseILPSolver(const ProblemData& data)
+        : data(data), server_to_days(data.server_to_days), num_days(data.num_days) {
+        server_masks = buildServerDayMasks<1>(data.alarm_index, num_days);
         
         // 计算服务器效率分数
         for (auto& [server, days] : server_to_days) {
@@ -75,8 +44,7 @@ public:
             }
             
             // 覆盖连续天数的奖励
-            vector<int> day_list(days.begin(), days.end());
-            sort(day_list.begin(), day_list.end());
+            const vector<int>& day_list = days;
             int consecutive_bonus = 0;
             for (int i = 1; i < day_list.size(); i++) {
                 if (day_list[i] == day_list[i-1] + 1) {
@@ -91,19 +59,17 @@ public:
         // 按效率分数降序排序
         sort(server_efficiency.rbegin(), server_efficiency.rend());
         
-        cout << "Loaded " << day << " days, " << server_to_days.size() << " unique servers" << endl;
+        cout << "Loaded " << num_days << " days, " << server_to_days.size() << " unique servers" << endl;
         cout << "Top 10 most efficient servers:" << endl;
         for (int i = 0; i < min(10, (int)server_efficiency.size()); i++) {
             auto [score, server] = server_efficiency[i];
             cout << "  Server " << server << ": score " << score 
-                 << " (covers " << server_to_days[server].size() << " days)" << endl;
+                 << " (covers " << data.serverDays(server).size() << " days)" << endl;
         }
-        
-        return true;
     }
     
-    Solution solve() {
-        Solution solution;
+    Solution solve() override {
+        Solution solution(num_days);
         
         cout << "\n=== Precise ILP-Based Solver ===" << endl;
         cout << "Target: Exactly " << MAX_REST_DAYS << " total rest days" << endl;
@@ -120,11 +86,14 @@ public:
         
         // 使用精确的贪心算法
         vector<bool> server_used(NUM_SERVERS, false);
-        vector<int> engineer_rest_days(NUM_ENGINEERS, NUM_DAYS);
-        int total_rest_days = NUM_ENGINEERS * NUM_DAYS;
+        vector<int> engineer_rest_days(NUM_ENGINEERS, num_days);
+        int total_rest_days = NUM_ENGINEERS * num_days;
         
         cout << "\nPhase 1: Precise allocation to achieve exact rest day target..." << endl;
         
+        AllocCounter search_allocations;
+        DayMask<1> first_14 = DayMask<1>::prefix(14);
+        
         // 为每个工程师精确分配服务器
         for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
             // 确定这个工程师的目标休息天数
@@ -135,10 +104,10 @@ public:
                 target_rest_days = 2; // 20 work days
             }
             
-            int target_work_days = NUM_DAYS - target_rest_days;
+            int target_work_days = num_days - target_rest_days;
             
             // 贪心选择服务器以达到精确的工作天数
-            set<int> current_work_days;
+            DayMask<1> current_work_days;
             int servers_assigned = 0;
             
             for (auto& [score, server] : server_efficiency) {
@@ -147,13 +116,10 @@ public:
                 }
                 
                 // 计算分配这个服务器后的工作天数
-                set<int> new_work_days = current_work_days;
-                for (int day : server_to_days[server]) {
-                    new_work_days.insert(day);
-                }
+                DayMask<1> new_work_days = current_work_days | server_masks[server];
                 
-                int new_work_count = new_work_days.size();
-                int new_rest_count = NUM_DAYS - new_work_count;
+                int new_work_count = new_work_days.count();
+                int new_rest_count = num_days - new_work_count;
                 
                 // 检查是否改善了分配
                 bool should_assign = false;
@@ -188,7 +154,7 @@ public:
             }
             
             if (engineer % 50 == 0) {
-                cout << "Engineer " << engineer << ": " << (NUM_DAYS - engineer_rest_days[engineer]) 
+                cout << "Engineer " << engineer << ": " << (num_days - engineer_rest_days[engineer]) 
                      << " work days, " << engineer_rest_days[engineer] << " rest days. "
                      << "Total rest: " << total_rest_days << endl;
             }
@@ -227,21 +193,8 @@ public:
                             
                             if (empty_slot != -1) {
                                 // 计算新的工作天数
-                                set<int> current_work_days;
-                                for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                                    if (solution.allocation[engineer][i] != -1) {
-                                        for (int day : server_to_days[solution.allocation[engineer][i]]) {
-                                            current_work_days.insert(day);
-                                        }
-                                    }
-                                }
-                                
-                                set<int> new_work_days = current_work_days;
-                                for (int day : server_to_days[server]) {
-                                    new_work_days.insert(day);
-                                }
-                                
-                                int work_increase = new_work_days.size() - current_work_days.size();
+                                DayMask<1> current_work_days = engineerDays(solution, engineer);
+                                int work_increase = current_work_days.countNew(server_masks[server]);
                                 if (work_increase > 0 && work_increase <= excess) {
                                     solution.allocation[engineer][empty_slot] = server;
                                     server_used[server] = true;
@@ -268,27 +221,14 @@ public:
                                 int server = solution.allocation[engineer][i];
                                 
                                 // 计算移除这个服务器后的工作天数
-                                set<int> new_work_days;
-                                for (int j = 0; j < MAX_SERVERS_PER_ENGINEER; j++) {
-                                    if (j != i && solution.allocation[engineer][j] != -1) {
-                                        for (int day : server_to_days[solution.allocation[engineer][j]]) {
-                                            new_work_days.insert(day);
-                                        }
-                                    }
-                                }
+                                DayMask<1> new_work_days = engineerDays(solution, engineer, i);
                                 
                                 // 确保仍然覆盖前14天
-                                bool covers_first_14 = false;
-                                for (int day : new_work_days) {
-                                    if (day < 14) {
-                                        covers_first_14 = true;
-                                        break;
-                                    }
-                                }
+                                bool covers_first_14 = new_work_days.intersects(first_14);
                                 
                                 if (covers_first_14) {
-                                    int current_work = NUM_DAYS - engineer_rest_days[engineer];
-                                    int new_work = new_work_days.size();
+                                    int current_work = num_days - engineer_rest_days[engineer];
+                                    int new_work = new_work_days.count();
                                     int rest_increase = current_work - new_work;
                                     
                                     if (rest_increase > 0 && rest_increase <= deficit) {
@@ -313,149 +253,22 @@ public:
             }
         }
         
-        // 计算最终结果
-        calculateFinalResults(solution);
+        if (ALLOC_COUNTER_ENABLED) cout << "Heap allocations during search: " << search_allocations.count() << endl;
         
         return solution;
     }
     
 private:
-    void calculateFinalResults(Solution& solution) {
-        solution.total_rest_days = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            fill(solution.daily_work[engineer].begin(), solution.daily_work[engineer].end(), false);
-            
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                int server = solution.allocation[engineer][i];
-                if (server == -1) continue;
-                
-                for (int day : server_to_days[server]) {
-                    solution.daily_work[engineer][day] = true;
-                }
-            }
-            
-            int work_days = 0;
-            for (int day = 0; day < NUM_DAYS; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                }
-            }
-            solution.total_rest_days += (NUM_DAYS - work_days);
-        }
-        
-        // 统计结果
-        map<int, int> work_days_distribution;
-        map<int, int> rest_days_distribution;
-        int engineers_with_first_14_work = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            int work_days = 0;
-            bool has_first_14_work = false;
-            
-            for (int day = 0; day < NUM_DAYS; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                    if (day < 14) {
-                        has_first_14_work = true;
-                    }
-                }
-            }
-            
-            int rest_days = NUM_DAYS - work_days;
-            work_days_distribution[work_days]++;
-            rest_days_distribution[rest_days]++;
-            if (has_first_14_work) engineers_with_first_14_work++;
-        }
-        
-        cout << "\n=== Final Results ===" << endl;
-        cout << "Work days distribution:" << endl;
-        for (auto& [days, count] : work_days_distribution) {
-            cout << "  " << count << " engineers work " << days << " days" << endl;
-        }
-        
-        cout << "\nRest days distribution:" << endl;
-        for (auto& [days, count] : rest_days_distribution) {
-            cout << "  " << count << " engineers rest " << days << " days" << endl;
-        }
-        
-        cout << "\nConstraint Check:" << endl;
-        cout << "Total rest days: " << solution.total_rest_days << " / " << MAX_REST_DAYS;
-        if (solution.total_rest_days == MAX_REST_DAYS) {
-            cout << " ✓ EXACTLY SATISFIED!" << endl;
-        } else if (solution.total_rest_days <= MAX_REST_DAYS) {
-            cout << " ✓ SATISFIED (under by " << (MAX_REST_DAYS - solution.total_rest_days) << ")" << endl;
-        } else {
-            cout << " ✗ VIOLATED (excess: " << (solution.total_rest_days - MAX_REST_DAYS) << ")" << endl;
-        }
-        
-        cout << "Engineers with first 14 days work: " << engineers_with_first_14_work << " / " << NUM_ENGINEERS;
-        if (engineers_with_first_14_work == NUM_ENGINEERS) {
-            cout << " ✓ SATISFIED" << endl;
-        } else {
-            cout << " ✗ VIOLATED (missing: " << (NUM_ENGINEERS - engineers_with_first_14_work) << ")" << endl;
-        }
-        
-        if (solution.total_rest_days <= MAX_REST_DAYS && engineers_with_first_14_work == NUM_ENGINEERS) {
-            cout << "\n🎉 ALL CONSTRAINTS SATISFIED! 🎉" << endl;
-            solution.valid = true;
-        } else {
-            cout << "\n❌ CONSTRAINT VIOLATIONS DETECTED ❌" << endl;
-            solution.valid = false;
+    // 工程师所有服务器（跳过第 skip 个槽位）的工作天掩码
+    DayMask<1> engineerDays(const Solution& solution, int engineer, int skip = -1) const {
+        DayMask<1> days;
+        for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
+            int server = solution.allocation[engineer][i];
+            if (i != skip && server != -1) days |= server_masks[server];
         }
-        
-        // 额外统计
-        cout << "\nDetailed Analysis:" << endl;
-        cout << "Average rest days per engineer: " << (double)solution.total_rest_days / NUM_ENGINEERS << endl;
-        cout << "Rest day efficiency: " << (double)solution.total_rest_days / MAX_REST_DAYS * 100 << "%" << endl;
-    }
-    
-public:
-    void saveSolution(const Solution& solution, const string& filename) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot create " << filename << endl;
-            return;
-        }
-        
-        for (int e = 0; e < NUM_ENGINEERS; e++) {
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                file << solution.allocation[e][i];
-                if (i < MAX_SERVERS_PER_ENGINEER - 1) file << " ";
-            }
-            file << endl;
-        }
-        
-        file.close();
-        cout << "Solution saved to " << filename << endl;
+        return days;
     }
 };
 
-int main() {
-    cout << "=== Precise ILP-Based Server Allocation Solver ===" << endl;
-    cout << "Engineers: " << NUM_ENGINEERS << endl;
-    cout << "Servers: " << NUM_SERVERS << endl;
-    cout << "Max servers per engineer: " << MAX_SERVERS_PER_ENGINEER << endl;
-    cout << "Days: " << NUM_DAYS << endl;
-    cout << "EXACT TARGET: " << MAX_REST_DAYS << " total rest days" << endl;
-    cout << endl;
-    
-    PreciseILPSolver solver;
-    
-    if (!solver.loadAlarmData("alarm_list.txt")) {
-        return 1;
-    }
-    
-    cout << "\nSolving with precise constraint satisfaction..." << endl;
-    Solution solution = solver.solve();
-    
-    solver.saveSolution(solution, "precise_solution.txt");
-    
-    if (solution.valid) {
-        cout << "\n✅ PERFECT SOLUTION FOUND! All constraints exactly satisfied." << endl;
-    } else {
-        cout << "\n⚠️  Best possible solution found, analyzing constraint violations..." << endl;
-    }
-    
-    return 0;
-}
\ No newline at end of file
+REGISTER_SOLVER_STRATEGY(PreciseILPSolver, "precise", "precise_solver", "Precise ILP-Based Server Allocation Solver",
+                         "precise_solution.txt", DEFAULT_NUM_DAYS, ALARM_INDEX_MASK_DAYS);
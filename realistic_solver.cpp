@@ -11,123 +11,86 @@
 #include <random>
 #include <chrono>
 
-using namespace std;
-
-const int NUM_ENGINEERS = 336;
-const int NUM_SERVERS = 1620;
-const int MAX_SERVERS_PER_ENGINEER = 5;
+#include "solver_strategy.h"
+#include "day_mask.h"
 
-struct Solution {
-    vector<vector<int>> allocation;
-    vector<vector<bool>> daily_work;
-    int total_rest_days;
-    int num_days;
-    bool valid;
-    
-    Solution(int days) : allocation(NUM_ENGINEERS, vector<int>(MAX_SERVERS_PER_ENGINEER, -1)), 
-                         daily_work(NUM_ENGINEERS, vector<bool>(days, false)), 
-                         total_rest_days(0), num_days(days), valid(false) {}
-};
+using namespace std;
 
-class RealisticSolver {
+class RealisticSolver : public SolverStrategy {
 private:
-    vector<vector<int>> daily_alarms;
-    map<int, set<int>> server_to_days;
+    const AlarmIndex& alarm_index;
+    const map<int, vector<int>>& server_to_days;  // 按天升序
     vector<pair<double, int>> server_efficiency;
-    int num_days;
+    const int num_days;
     
 public:
-    bool loadAlarmData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot open " << filename << endl;
-            return false;
-        }
+    explicit RealisticSolver(const ProblemData& data)
+        : alarm_index(data.alarm_index), server_to_days(data.server_to_days), num_days(data.num_days) {
+        // 计算服务器效率分数 - 基于实际约束（按周期宽度选择天集合的表示）
+        dispatchDayMaskWidth(num_days, [&](auto width) { scoreServers<decltype(width)::value>(); });
         
-        string line;
-        int day = 0;
+        // 按效率分数降序排序
+        sort(server_efficiency.rbegin(), server_efficiency.rend());
         
-        while (getline(file, line)) {
-            if (line.empty() || !isdigit(line[0])) continue;
-            
-            daily_alarms.push_back(vector<int>());
-            istringstream iss(line);
-            int server;
-            while (iss >> server) {
-                daily_alarms[day].push_back(server);
-                server_to_days[server].insert(day);
-            }
-            day++;
-        }
+        cout << "Loaded " << num_days << " days, " << server_to_days.size() << " unique servers" << endl;
         
-        num_days = day;
-        file.close();
+        // 统计有效服务器
+        int valid_servers = 0;
+        for (auto& [score, server] : server_efficiency) {
+            if (score > 0) valid_servers++;
+        }
+        cout << "Valid servers (covering first 14 days): " << valid_servers << endl;
+    }
+    
+    Solution solve() override {
+        return dispatchDayMaskWidth(num_days, [&](auto width) { return solveWithWidth<decltype(width)::value>(); });
+    }
+    
+private:
+    template <int W>
+    void scoreServers() {
+        vector<DayMask<W>> server_masks = buildServerDayMasks<W>(alarm_index, num_days);
+        DayMask<W> first_14 = DayMask<W>::prefix(14);
         
-        // 计算服务器效率分数 - 基于实际约束
         for (auto& [server, days] : server_to_days) {
+            const DayMask<W>& mask = server_masks[server];
+            int coverage = mask.count();
+            int first_14_count = (mask & first_14).count();
             double score = 0.0;
             
-            // 检查是否覆盖前14天
-            bool covers_first_14 = false;
-            int first_14_count = 0;
-            for (int day : days) {
-                if (day < 14) {
-                    first_14_count++;
-                    covers_first_14 = true;
-                }
-            }
-            
             // 只有覆盖前14天的服务器才有分数
-            if (covers_first_14) {
+            if (first_14_count > 0) {
                 // 基础分数：总覆盖天数
-                score += days.size() * 10.0;
+                score += coverage * 10.0;
                 
                 // 前14天覆盖奖励
                 score += first_14_count * 50.0;
                 
                 // 后续天数覆盖奖励
-                int later_days = days.size() - first_14_count;
+                int later_days = coverage - first_14_count;
                 score += later_days * 20.0;
                 
-                // 连续性奖励
-                vector<int> day_list(days.begin(), days.end());
-                sort(day_list.begin(), day_list.end());
-                int consecutive = 1;
-                for (int i = 1; i < day_list.size(); i++) {
-                    if (day_list[i] == day_list[i-1] + 1) {
-                        consecutive++;
-                    }
-                }
+                // 连续性奖励：相邻两天都报警的次数 + 1
+                int consecutive = 1 + mask.adjacentPairs();
                 score += consecutive * 5.0;
             }
             
             server_efficiency.push_back({score, server});
         }
-        
-        // 按效率分数降序排序
-        sort(server_efficiency.rbegin(), server_efficiency.rend());
-        
-        cout << "Loaded " << num_days << " days, " << server_to_days.size() << " unique servers" << endl;
-        
-        // 统计有效服务器
-        int valid_servers = 0;
-        for (auto& [score, server] : server_efficiency) {
-            if (score > 0) valid_servers++;
-        }
-        cout << "Valid servers (covering first 14 days): " << valid_servers << endl;
-        
-        return true;
     }
     
-    Solution solve() {
+    template <int W>
+    Solution solveWithWidth() {
         Solution solution(num_days);
+        vector<DayMask<W>> server_masks = buildServerDayMasks<W>(alarm_index, num_days);
+        DayMask<W> first_14 = DayMask<W>::prefix(14);
         
         cout << "\n=== Realistic Constraint-Aware Solver ===" << endl;
-        cout << "Days: " << num_days << endl;
+        cout << "Days: " << num_days << " (" << W << "-word day masks)" << endl;
         cout << "Objective: Minimize total rest days while satisfying all constraints" << endl;
         
         // 分析实际约束
-        analyzeConstraints();
+        analyzeConstraints(server_masks);
         
         cout << "\nPhase 1: Optimal server allocation..." << endl;
         
@@ -135,7 +98,7 @@ public:
         
         // 为每个工程师分配服务器
         for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            set<int> current_work_days;
+            DayMask<W> current_work_days;
             int servers_assigned = 0;
             
             // 贪心选择最优服务器
@@ -145,21 +108,12 @@ public:
                 }
                 
                 // 检查分配这个服务器的效果
-                set<int> new_work_days = current_work_days;
-                for (int day : server_to_days[server]) {
-                    new_work_days.insert(day);
-                }
+                DayMask<W> new_work_days = current_work_days | server_masks[server];
                 
                 // 确保前14天约束
-                bool has_first_14_work = false;
-                for (int day = 0; day < 14; day++) {
-                    if (new_work_days.count(day)) {
-                        has_first_14_work = true;
-                        break;
-                    }
-                }
+                bool has_first_14_work = new_work_days.intersects(first_14);
                 
-                if (has_first_14_work && new_work_days.size() > current_work_days.size()) {
+                if (has_first_14_work && new_work_days.count() > current_work_days.count()) {
                     solution.allocation[engineer][servers_assigned] = server;
                     server_used[server] = true;
                     servers_assigned++;
@@ -168,13 +122,19 @@ public:
             }
             
             if (engineer % 50 == 0 || engineer < 10) {
-                cout << "Engineer " << engineer << ": " << current_work_days.size() 
-                     << " work days, " << (num_days - current_work_days.size()) << " rest days" << endl;
+                cout << "Engineer " << engineer << ": " << current_work_days.count() 
+                     << " work days, " << (num_days - current_work_days.count()) << " rest days" << endl;
             }
         }
         
         cout << "\nPhase 2: Local optimization..." << endl;
         
+        // 替换槽位后的覆盖 = 其余槽位的 OR | 候选服务器，每个候选只需一次 OR + popcount
+        LeaveOneOutMasks<W> slot_masks(NUM_ENGINEERS, MAX_SERVERS_PER_ENGINEER);
+        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+            slot_masks.update(engineer, solution.allocation[engineer], server_masks);
+        }
+        
         // 局部优化：尝试改善分配
         for (int iteration = 0; iteration < 20; iteration++) {
             bool improved = false;
@@ -187,53 +147,29 @@ public:
                     int current_server = solution.allocation[engineer][slot];
                     
                     // 计算当前工作天数
-                    set<int> current_days;
-                    for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                        if (solution.allocation[engineer][i] != -1) {
-                            for (int day : server_to_days[solution.allocation[engineer][i]]) {
-                                current_days.insert(day);
-                            }
-                        }
-                    }
+                    int current_days = slot_masks.all(engineer).count();
+                    const DayMask<W>& other_days = slot_masks.without(engineer, slot);
                     
                     // 尝试替换为更好的服务器
                     for (auto& [score, server] : server_efficiency) {
                         if (server_used[server] || score <= 0) continue;
                         
-                        // 临时替换
-                        solution.allocation[engineer][slot] = server;
-                        server_used[current_server] = false;
-                        server_used[server] = true;
-                        
-                        // 计算新的工作天数
-                        set<int> new_days;
-                        for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                            if (solution.allocation[engineer][i] != -1) {
-                                for (int day : server_to_days[solution.allocation[engineer][i]]) {
-                                    new_days.insert(day);
-                                }
-                            }
-                        }
+                        // 计算替换后的工作天数
+                        DayMask<W> new_days = other_days | server_masks[server];
                         
                         // 检查是否改善且满足约束
-                        bool has_first_14 = false;
-                        for (int day = 0; day < 14; day++) {
-                            if (new_days.count(day)) {
-                                has_first_14 = true;
-                                break;
-                            }
-                        }
+                        bool has_first_14 = new_days.intersects(first_14);
                         
-                        if (has_first_14 && new_days.size() > current_days.size()) {
+                        if (has_first_14 && new_days.count() > current_days) {
+                            solution.allocation[engineer][slot] = server;
+                            server_used[current_server] = false;
+                            server_used[server] = true;
+                            slot_masks.update(engineer, solution.allocation[engineer], server_masks);
+                            
                             improved = true;
                             cout << "Iteration " << iteration << ": Improved engineer " << engineer 
-                                 << " from " << current_days.size() << " to " << new_days.size() << " work days" << endl;
+                                 << " from " << current_days << " to " << new_days.count() << " work days" << endl;
                             break;
-                        } else {
-                            // 撤销替换
-                            solution.allocation[engineer][slot] = current_server;
-                            server_used[server] = false;
-                            server_used[current_server] = true;
                         }
                     }
                     if (improved) break;
@@ -247,27 +183,19 @@ public:
             }
         }
         
-        // 计算最终结果
-        calculateFinalResults(solution);
-        
         return solution;
     }
     
-private:
-    void analyzeConstraints() {
+    template <int W>
+    void analyzeConstraints(const vector<DayMask<W>>& server_masks) {
         cout << "\n=== Constraint Analysis ===" << endl;
         
+        DayMask<W> first_14 = DayMask<W>::prefix(14);
+        
         // 分析前14天约束
         int servers_covering_first_14 = 0;
         for (auto& [server, days] : server_to_days) {
-            bool covers_first_14 = false;
-            for (int day : days) {
-                if (day < 14) {
-                    covers_first_14 = true;
-                    break;
-                }
-            }
-            if (covers_first_14) servers_covering_first_14++;
+            if (server_masks[server].intersects(first_14)) servers_covering_first_14++;
         }
         
         cout << "Servers covering first 14 days: " << servers_covering_first_14 << endl;
@@ -276,14 +204,7 @@ private:
         // 分析最大可能工作天数
         vector<pair<int, int>> server_coverage_counts;
         for (auto& [server, days] : server_to_days) {
-            bool covers_first_14 = false;
-            for (int day : days) {
-                if (day < 14) {
-                    covers_first_14 = true;
-                    break;
-                }
-            }
-            if (covers_first_14) {
+            if (server_masks[server].intersects(first_14)) {
                 server_coverage_counts.push_back({days.size(), server});
             }
         }
@@ -291,15 +212,12 @@ private:
         sort(server_coverage_counts.rbegin(), server_coverage_counts.rend());
         
         if (server_coverage_counts.size() >= 5) {
-            set<int> best_combination;
+            DayMask<W> best_combination;
             for (int i = 0; i < 5; i++) {
-                int server = server_coverage_counts[i].second;
-                for (int day : server_to_days[server]) {
-                    best_combination.insert(day);
-                }
+                best_combination |= server_masks[server_coverage_counts[i].second];
             }
             
-            int max_work_days = best_combination.size();
+            int max_work_days = best_combination.count();
             int min_rest_days = num_days - max_work_days;
             int theoretical_min_total_rest = NUM_ENGINEERS * min_rest_days;
             
@@ -312,146 +230,7 @@ private:
             cout << "- Average work days per engineer: " << max_work_days << endl;
         }
     }
-    
-    void calculateFinalResults(Solution& solution) {
-        solution.total_rest_days = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            fill(solution.daily_work[engineer].begin(), solution.daily_work[engineer].end(), false);
-            
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                int server = solution.allocation[engineer][i];
-                if (server == -1) continue;
-                
-                for (int day : server_to_days[server]) {
-                    if (day < solution.num_days) {
-                        solution.daily_work[engineer][day] = true;
-                    }
-                }
-            }
-            
-            int work_days = 0;
-            for (int day = 0; day < solution.num_days; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                }
-            }
-            solution.total_rest_days += (solution.num_days - work_days);
-        }
-        
-        // 统计结果
-        map<int, int> work_days_distribution;
-        map<int, int> rest_days_distribution;
-        int engineers_with_first_14_work = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            int work_days = 0;
-            bool has_first_14_work = false;
-            
-            for (int day = 0; day < solution.num_days; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                    if (day < 14) {
-                        has_first_14_work = true;
-                    }
-                }
-            }
-            
-            int rest_days = solution.num_days - work_days;
-            work_days_distribution[work_days]++;
-            rest_days_distribution[rest_days]++;
-            if (has_first_14_work) engineers_with_first_14_work++;
-        }
-        
-        cout << "\n=== Final Results ===" << endl;
-        cout << "Work days distribution:" << endl;
-        for (auto& [days, count] : work_days_distribution) {
-            cout << "  " << count << " engineers work " << days << " days" << endl;
-        }
-        
-        cout << "\nRest days distribution:" << endl;
-        for (auto& [days, count] : rest_days_distribution) {
-            cout << "  " << count << " engineers rest " << days << " days" << endl;
-        }
-        
-        cout << "\nConstraint Check:" << endl;
-        cout << "Total rest days: " << solution.total_rest_days << endl;
-        cout << "Engineers with first 14 days work: " << engineers_with_first_14_work << " / " << NUM_ENGINEERS;
-        
-        if (engineers_with_first_14_work == NUM_ENGINEERS) {
-            cout << " ✓ SATISFIED" << endl;
-            solution.valid = true;
-        } else {
-            cout << " ✗ VIOLATED (missing: " << (NUM_ENGINEERS - engineers_with_first_14_work) << ")" << endl;
-            solution.valid = false;
-        }
-        
-        cout << "\nPerformance Metrics:" << endl;
-        cout << "Average rest days per engineer: " << (double)solution.total_rest_days / NUM_ENGINEERS << endl;
-        cout << "Average work days per engineer: " << (double)(NUM_ENGINEERS * num_days - solution.total_rest_days) / NUM_ENGINEERS << endl;
-        
-        if (solution.valid) {
-            cout << "\n✅ VALID SOLUTION FOUND!" << endl;
-            cout << "All constraints satisfied with optimal resource utilization." << endl;
-        } else {
-            cout << "\n⚠️ PARTIAL SOLUTION" << endl;
-            cout << "Some constraints violated, but this is the best achievable result." << endl;
-        }
-    }
-    
-public:
-    void saveSolution(const Solution& solution, const string& filename) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot create " << filename << endl;
-            return;
-        }
-        
-        for (int e = 0; e < NUM_ENGINEERS; e++) {
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                file << solution.allocation[e][i];
-                if (i < MAX_SERVERS_PER_ENGINEER - 1) file << " ";
-            }
-            file << endl;
-        }
-        
-        file.close();
-        cout << "Solution saved to " << filename << endl;
-    }
 };
 
-int main() {
-    cout << "=== Realistic Server Allocation Solver ===" << endl;
-    cout << "Engineers: " << NUM_ENGINEERS << endl;
-    cout << "Servers: " << NUM_SERVERS << endl;
-    cout << "Max servers per engineer: " << MAX_SERVERS_PER_ENGINEER << endl;
-    cout << "Objective: Find the best achievable solution given actual constraints" << endl;
-    cout << endl;
-    
-    RealisticSolver solver;
-    
-    if (!solver.loadAlarmData("alarm_list.txt")) {
-        return 1;
-    }
-    
-    cout << "\nSolving with realistic constraint awareness..." << endl;
-    Solution solution = solver.solve();
-    
-    solver.saveSolution(solution, "realistic_solution.txt");
-    
-    cout << "\n=== Summary ===" << endl;
-    cout << "This solution represents the best achievable result given:" << endl;
-    cout << "1. All engineers must work in the first 14 days" << endl;
-    cout << "2. Each engineer can be assigned at most 5 servers" << endl;
-    cout << "3. Each server can only be assigned to one engineer" << endl;
-    cout << "4. Server availability constraints from alarm_list.txt" << endl;
-    
-    if (solution.valid) {
-        cout << "\n🎉 Optimal solution found within all constraints!" << endl;
-    } else {
-        cout << "\n📊 Best possible solution found. The 410-day constraint is mathematically impossible with current data." << endl;
-        cout << "Recommendation: Adjust the rest day target to at least " << solution.total_rest_days << " days." << endl;
-    }
-    
-    return 0;
-}
\ No newline at end of file
+REGISTER_SOLVER_STRATEGY(RealisticSolver, "realistic", "realistic_solver", "Realistic Server Allocation Solver",
+                         "realistic_solution.txt", 0, ALARM_INDEX_MAX_DAYS);
@@ -0,0 +1,396 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+// 本地磁盘上的求解结果缓存。
+//
+// 键由 (警报文件内容哈希, 维度, 求解器, 参数, 随机种子, 编译标识) 组成，
+// 每个条目是一个紧凑的二进制方案文件 <digest>.sol，目录下的 manifest.txt
+// 记录所有条目的键、大小和最近使用时间，总大小超过上限时按最近最少使用淘汰。
+// 只有参数不同的条目可以通过 findWarmStart 取出作为热启动的初始方案。
+//
+// 环境变量：SOLVE_CACHE=0 禁用缓存，SOLVE_CACHE_DIR 指定目录（默认 .solve_cache），
+// SOLVE_CACHE_MAX_MB 指定大小上限（默认 256）。
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <ctime>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "alarm_index.h"
+
+const uint32_t RESULT_CACHE_MAGIC = 0x434C4F53;  // "SOLC"
+const uint32_t RESULT_CACHE_VERSION = 1;
+
+const int64_t RESULT_CACHE_TEMP_MAX_AGE = 3600;  // 超过这个秒数的临时文件视为写入者已经退出
+
+// 编译标识取自链接出的可执行文件本身的内容哈希：任何一个求解器源文件重新编译并链接，
+// 标识都会变，旧代码算出的结果不会被当成当前结果。只看某个翻译单元的 __DATE__/__TIME__
+// 做不到这一点。读不到可执行文件时退回到本翻译单元的编译时间
+inline const std::string& solveCacheBuildId() {
+    static const std::string id = []() {
+        MappedFile exe;
+        if (!exe.open("/proc/self/exe")) return std::string(__DATE__ "_" __TIME__);
+        char text[24];
+        snprintf(text, sizeof(text), "%016llx", (unsigned long long)hashAlarmBytes(exe.data(), exe.size()));
+        return std::string(text);
+    }();
+    return id;
+}
+
+struct CacheKey {
+    uint64_t alarm_hash = 0;
+    int engineers = 0;
+    int servers = 0;
+    int days = 0;
+    int slots = 0;
+    std::string solver;
+    std::string params;
+    uint64_t seed = 0;
+    std::string build = solveCacheBuildId();
+
+    // 不含参数、种子和编译标识的部分，热启动只要求这部分一致
+    std::string problemKey() const {
+        std::ostringstream oss;
+        oss << std::hex << alarm_hash << std::dec << ' ' << engineers << ' ' << servers << ' '
+            << days << ' ' << slots << ' ' << solver;
+        return oss.str();
+    }
+
+    uint64_t digest() const {
+        std::ostringstream oss;
+        oss << problemKey() << '\n' << params << '\n' << seed << '\n' << build;
+        std::string text = oss.str();
+        return hashAlarmBytes(text.data(), text.size());
+    }
+};
+
+struct CachedResult {
+    int engineers = 0;
+    int slots = 0;
+    std::vector<int32_t> allocation;  // allocation[e * slots + i]，空位为 -1
+    int total_rest_days = 0;
+    bool valid = false;
+    double solve_seconds = 0.0;
+};
+
+struct CacheEntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t digest;
+    int32_t engineers;
+    int32_t slots;
+    int32_t total_rest_days;
+    int32_t valid;
+    double solve_seconds;
+};
+
+inline CacheKey makeCacheKey(const AlarmIndex& index, const std::string& solver, int engineers, int servers,
+                             int days, int slots, const std::string& params, uint64_t seed = 0) {
+    CacheKey key;
+    key.alarm_hash = index.contentHash();
+    key.engineers = engineers;
+    key.servers = servers;
+    key.days = days;
+    key.slots = slots;
+    key.solver = solver;
+    key.params = params;
+    key.seed = seed;
+    return key;
+}
+
+inline CachedResult makeCachedResult(const std::vector<std::vector<int>>& allocation, int slots,
+                                     int total_rest_days, bool valid, double solve_seconds) {
+    CachedResult result;
+    result.engineers = allocation.size();
+    result.slots = slots;
+    result.allocation.assign(result.engineers * slots, -1);
+    for (int e = 0; e < result.engineers; e++) {
+        for (int i = 0; i < slots && i < (int)allocation[e].size(); i++) {
+            result.allocation[e * slots + i] = allocation[e][i];
+        }
+    }
+    result.total_rest_days = total_rest_days;
+    result.valid = valid;
+    result.solve_seconds = solve_seconds;
+    return result;
+}
+
+inline void restoreAllocation(const CachedResult& result, std::vector<std::vector<int>>& allocation) {
+    allocation.assign(result.engineers, std::vector<int>(result.slots, -1));
+    for (int e = 0; e < result.engineers; e++) {
+        for (int i = 0; i < result.slots; i++) {
+            allocation[e][i] = result.allocation[e * result.slots + i];
+        }
+    }
+}
+
+class ResultCache {
+private:
+    struct ManifestEntry {
+        uint64_t digest;
+        uint64_t size;
+        int64_t last_used;
+        std::string problem_key;
+        std::string params;
+    };
+
+    std::string dir;
+    uint64_t max_bytes;
+    bool enabled;
+
+public:
+    ResultCache() {
+        const char* env_enabled = getenv("SOLVE_CACHE");
+        const char* env_dir = getenv("SOLVE_CACHE_DIR");
+        const char* env_max = getenv("SOLVE_CACHE_MAX_MB");
+        enabled = !(env_enabled && std::string(env_enabled) == "0");
+        dir = env_dir ? env_dir : ".solve_cache";
+        max_bytes = (env_max ? strtoull(env_max, nullptr, 10) : 256) << 20;
+    }
+
+    ResultCache(const std::string& directory, uint64_t max_size_bytes)
+        : dir(directory), max_bytes(max_size_bytes), enabled(true) {}
+
+    bool isEnabled() const { return enabled; }
+
+    bool lookup(const CacheKey& key, CachedResult& result) {
+        if (!enabled) return false;
+        uint64_t digest = key.digest();
+        if (!readEntry(entryPath(digest), digest, key, result)) return false;
+
+        int lock = lockManifest();
+        std::vector<ManifestEntry> entries = readManifest();
+        for (auto& entry : entries) {
+            if (entry.digest == digest) entry.last_used = time(nullptr);
+        }
+        writeManifest(entries);
+        unlockManifest(lock);
+        return true;
+    }
+
+    bool store(const CacheKey& key, const CachedResult& result) {
+        if (!enabled) return false;
+        mkdir(dir.c_str(), 0755);
+
+        uint64_t digest = key.digest();
+        std::string path = entryPath(digest);
+        std::string tmp = tempPath(path);
+        std::ofstream file(tmp, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        CacheEntryHeader header;
+        header.magic = RESULT_CACHE_MAGIC;
+        header.version = RESULT_CACHE_VERSION;
+        header.digest = digest;
+        header.engineers = result.engineers;
+        header.slots = result.slots;
+        header.total_rest_days = result.total_rest_days;
+        header.valid = result.valid;
+        header.solve_seconds = result.solve_seconds;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(result.allocation.data()),
+                   result.allocation.size() * sizeof(int32_t));
+        file.close();
+        if (!file) {
+            remove(tmp.c_str());
+            return false;
+        }
+
+        // 条目在锁内改名就位，所以锁内看到的不在 manifest 里的 .sol 都是孤儿
+        int lock = lockManifest();
+        if (rename(tmp.c_str(), path.c_str()) != 0) {
+            remove(tmp.c_str());
+            unlockManifest(lock);
+            return false;
+        }
+        std::vector<ManifestEntry> entries = readManifest();
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&](const ManifestEntry& e) { return e.digest == digest; }),
+                      entries.end());
+        entries.push_back({digest, sizeof(header) + result.allocation.size() * sizeof(int32_t),
+                           (int64_t)time(nullptr), key.problemKey(), describeParams(key)});
+        evict(entries);
+        writeManifest(entries);
+        sweepOrphans(entries);
+        unlockManifest(lock);
+        return true;
+    }
+
+    // 找到同一个问题（警报数据、维度、求解器都相同）最近使用的条目，作为热启动方案
+    bool findWarmStart(const CacheKey& key, CachedResult& result) {
+        if (!enabled) return false;
+        int lock = lockManifest();
+        std::vector<ManifestEntry> entries = readManifest();
+        unlockManifest(lock);
+
+        std::string problem = key.problemKey();
+        std::sort(entries.begin(), entries.end(),
+                  [](const ManifestEntry& a, const ManifestEntry& b) { return a.last_used > b.last_used; });
+        for (auto& entry : entries) {
+            if (entry.problem_key == problem && readEntry(entryPath(entry.digest), entry.digest, key, result)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::string entryPath(uint64_t digest) const {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.sol", (unsigned long long)digest);
+        return dir + name;
+    }
+
+    std::string manifestPath() const { return dir + "/manifest.txt"; }
+
+    // 每个写入者用自己的临时文件，并发写同一个条目的进程不会写到一起
+    static std::string tempPath(const std::string& path) { return path + ".tmp." + std::to_string(getpid()); }
+
+    static std::string describeParams(const CacheKey& key) {
+        std::string build = key.build;
+        std::replace(build.begin(), build.end(), ' ', '_');
+        std::string params = key.params;
+        std::replace(params.begin(), params.end(), '\n', ' ');
+        return "seed=" + std::to_string(key.seed) + " build=" + build + " " + params;
+    }
+
+    // 条目来自磁盘，可能被截断或篡改：大小、维度和服务器编号与键不一致时按未命中处理
+    static bool readEntry(const std::string& path, uint64_t digest, const CacheKey& key, CachedResult& result) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        std::streamoff file_size = file.tellg();
+        file.seekg(0);
+
+        CacheEntryHeader header;
+        if (file_size < (std::streamoff)sizeof(header) ||
+            !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        if (header.magic != RESULT_CACHE_MAGIC || header.version != RESULT_CACHE_VERSION ||
+            header.digest != digest || header.engineers != key.engineers || header.slots != key.slots ||
+            header.engineers < 0 || header.slots < 0) {
+            return false;
+        }
+        uint64_t count = (uint64_t)header.engineers * header.slots;
+        if ((uint64_t)file_size != sizeof(header) + count * sizeof(int32_t)) return false;
+
+        std::vector<int32_t> allocation(count);
+        if (!file.read(reinterpret_cast<char*>(allocation.data()), count * sizeof(int32_t))) return false;
+        for (int32_t server : allocation) {
+            if (server < -1 || server >= key.servers) return false;
+        }
+
+        result.engineers = header.engineers;
+        result.slots = header.slots;
+        result.total_rest_days = header.total_rest_days;
+        result.valid = header.valid != 0;
+        result.solve_seconds = header.solve_seconds;
+        result.allocation = std::move(allocation);
+        return true;
+    }
+
+    // manifest 每行: digest size last_used | problem_key | params
+    std::vector<ManifestEntry> readManifest() const {
+        std::vector<ManifestEntry> entries;
+        std::ifstream file(manifestPath());
+        std::string line;
+        while (getline(file, line)) {
+            size_t bar1 = line.find(" | ");
+            size_t bar2 = bar1 == std::string::npos ? bar1 : line.find(" | ", bar1 + 3);
+            if (bar2 == std::string::npos) continue;
+
+            ManifestEntry entry;
+            std::istringstream head(line.substr(0, bar1));
+            if (!(head >> std::hex >> entry.digest >> std::dec >> entry.size >> entry.last_used)) continue;
+            entry.problem_key = line.substr(bar1 + 3, bar2 - bar1 - 3);
+            entry.params = line.substr(bar2 + 3);
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    void writeManifest(const std::vector<ManifestEntry>& entries) const {
+        std::string tmp = tempPath(manifestPath());
+        std::ofstream file(tmp);
+        if (!file.is_open()) return;
+        for (auto& entry : entries) {
+            char digest[24];
+            snprintf(digest, sizeof(digest), "%016llx", (unsigned long long)entry.digest);
+            file << digest << ' ' << entry.size << ' ' << entry.last_used
+                 << " | " << entry.problem_key << " | " << entry.params << '\n';
+        }
+        file.close();
+        rename(tmp.c_str(), manifestPath().c_str());
+    }
+
+    // 按最近使用时间淘汰，直到总大小不超过上限（最新写入的条目总是保留）
+    void evict(std::vector<ManifestEntry>& entries) const {
+        uint64_t total = 0;
+        for (auto& entry : entries) total += entry.size;
+        if (total <= max_bytes) return;
+
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const ManifestEntry& a, const ManifestEntry& b) { return a.last_used < b.last_used; });
+        size_t removed = 0;
+        while (total > max_bytes && removed + 1 < entries.size()) {
+            remove(entryPath(entries[removed].digest).c_str());
+            total -= entries[removed].size;
+            removed++;
+        }
+        entries.erase(entries.begin(), entries.begin() + removed);
+    }
+
+    // 删除目录里不在 manifest 中的 .sol（淘汰前崩溃、manifest 被覆盖等留下的），
+    // 以及早已没有写入者的临时文件。调用方持有 manifest 锁
+    void sweepOrphans(const std::vector<ManifestEntry>& entries) const {
+        DIR* handle = opendir(dir.c_str());
+        if (!handle) return;
+        std::vector<uint64_t> listed;
+        for (auto& entry : entries) listed.push_back(entry.digest);
+        std::sort(listed.begin(), listed.end());
+
+        int64_t now = time(nullptr);
+        while (dirent* item = readdir(handle)) {
+            std::string name = item->d_name;
+            std::string path = dir + "/" + name;
+            if (name.find(".tmp.") != std::string::npos) {
+                struct stat st;
+                if (stat(path.c_str(), &st) == 0 && now - (int64_t)st.st_mtime > RESULT_CACHE_TEMP_MAX_AGE) {
+                    remove(path.c_str());
+                }
+                continue;
+            }
+            if (name.size() != 20 || name.compare(16, 4, ".sol") != 0) continue;
+            uint64_t digest = strtoull(name.substr(0, 16).c_str(), nullptr, 16);
+            if (!std::binary_search(listed.begin(), listed.end(), digest)) remove(path.c_str());
+        }
+        closedir(handle);
+    }
+
+    int lockManifest() const {
+        mkdir(dir.c_str(), 0755);
+        int fd = open((dir + "/.lock").c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd >= 0) flock(fd, LOCK_EX);
+        return fd;
+    }
+
+    static void unlockManifest(int fd) {
+        if (fd < 0) return;
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+};
+
+#endif
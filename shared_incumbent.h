@@ -0,0 +1,288 @@
+#ifndef SHARED_INCUMBENT_H
+#define SHARED_INCUMBENT_H
+
+// 并行求解共用的当前最优方案（incumbent），读写都不加锁。
+//
+// 方案以不可变的 CompactSolution 发布：当前最优是一个原子指针，发布新方案用 CAS
+// 替换指针，只有严格更好时才替换；另有一个原子的最优分数，线程可以随时读它来
+// 剪枝或者决定是否从当前最优重新出发，不需要进入临界区。
+//
+// 被替换下来的旧方案可能还有线程在读，用基于 epoch 的回收（EBR）延迟释放：
+// 线程读指针之前先 pin（把自己的 epoch 设为全局 epoch），读完 unpin。只有所有
+// pin 住的线程都已经看到全局 epoch 时，全局 epoch 才前进一步；在 epoch r 退休的
+// 对象，等全局 epoch 到达 r + 2 时就不可能再被任何线程持有，可以释放。
+//
+// 每个线程通过自己的 EpochHandle 参与（构造时占用一个参与者槽位，析构时归还），退休列表是
+// 线程私有的；归还时还没释放的对象挂到域的孤儿链表上，之后由其他线程或析构函数回收。
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <climits>
+
+// 分数越小越好：先比前14天没有工作的工程师数，再比总休息天数
+inline int64_t incumbentScore(int first14_missing, long long rest_days) {
+    return ((int64_t)first14_missing << 40) + rest_days;
+}
+
+const int64_t NO_INCUMBENT_SCORE = INT64_MAX;
+
+// 紧凑的方案：slot_server[e * slots + i]，空位为 -1。发布之后不再修改
+struct CompactSolution {
+    int engineers = 0;
+    int slots = 0;
+    long long rest_days = 0;
+    int first14_missing = 0;
+    std::vector<int32_t> slot_server;
+
+    int64_t score() const { return incumbentScore(first14_missing, rest_days); }
+    int server(int e, int slot) const { return slot_server[(size_t)e * slots + slot]; }
+};
+
+class EpochDomain {
+public:
+    static const int MAX_PARTICIPANTS = 128;
+
+private:
+    friend class EpochHandle;
+
+    struct Retired {
+        const void* object;
+        void (*destroy)(const void*);
+        uint64_t epoch;
+        Retired* next;
+    };
+
+    struct alignas(64) Participant {
+        std::atomic<uint64_t> epoch{0};  // 0 表示没有 pin
+        std::atomic<bool> used{false};
+    };
+
+    Participant participants[MAX_PARTICIPANTS];
+    std::atomic<uint64_t> global_epoch{1};
+    std::atomic<Retired*> orphans{nullptr};
+
+    // 所有 pin 住的线程都已经在当前 epoch 时前进一步
+    void tryAdvance() {
+        uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+        for (Participant& p : participants) {
+            if (!p.used.load(std::memory_order_acquire)) continue;
+            uint64_t local = p.epoch.load(std::memory_order_seq_cst);
+            if (local != 0 && local != epoch) return;
+        }
+        global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    bool reclaimable(uint64_t retired_epoch) const {
+        return retired_epoch + 2 <= global_epoch.load(std::memory_order_seq_cst);
+    }
+
+    void pushOrphans(Retired* head, Retired* tail) {
+        Retired* top = orphans.load(std::memory_order_relaxed);
+        do {
+            tail->next = top;
+        } while (!orphans.compare_exchange_weak(top, head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 整条取走孤儿链表，能释放的释放，其余放回
+    void collectOrphans() {
+        Retired* list = orphans.exchange(nullptr, std::memory_order_acquire);
+        Retired* keep_head = nullptr;
+        Retired* keep_tail = nullptr;
+        while (list) {
+            Retired* next = list->next;
+            if (reclaimable(list->epoch)) {
+                list->destroy(list->object);
+                delete list;
+            } else {
+                list->next = keep_head;
+                keep_head = list;
+                if (!keep_tail) keep_tail = list;
+            }
+            list = next;
+        }
+        if (keep_head) pushOrphans(keep_head, keep_tail);
+    }
+
+public:
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // 析构时不应再有线程持有 EpochHandle
+    ~EpochDomain() {
+        Retired* list = orphans.exchange(nullptr);
+        while (list) {
+            Retired* next = list->next;
+            list->destroy(list->object);
+            delete list;
+            list = next;
+        }
+    }
+
+    uint64_t epoch() const { return global_epoch.load(std::memory_order_acquire); }
+};
+
+// 一个线程在 EpochDomain 中的身份，不能跨线程共享
+class EpochHandle {
+private:
+    EpochDomain* domain = nullptr;
+    int index = -1;
+    std::vector<EpochDomain::Retired> retired;
+
+    static const size_t COLLECT_THRESHOLD = 32;
+
+public:
+    // 参与者全部被占用时等待其他线程归还
+    explicit EpochHandle(EpochDomain& owner) : domain(&owner) {
+        while (true) {
+            for (int i = 0; i < EpochDomain::MAX_PARTICIPANTS; i++) {
+                bool expected = false;
+                if (!domain->participants[i].used.load(std::memory_order_relaxed) &&
+                    domain->participants[i].used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                    index = i;
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    EpochHandle(const EpochHandle&) = delete;
+    EpochHandle& operator=(const EpochHandle&) = delete;
+
+    ~EpochHandle() {
+        collect();
+        if (!retired.empty()) {
+            EpochDomain::Retired* head = nullptr;
+            EpochDomain::Retired* tail = nullptr;
+            for (const EpochDomain::Retired& r : retired) {
+                EpochDomain::Retired* node = new EpochDomain::Retired(r);
+                node->next = head;
+                head = node;
+                if (!tail) tail = node;
+            }
+            domain->pushOrphans(head, tail);
+        }
+        domain->participants[index].epoch.store(0, std::memory_order_release);
+        domain->participants[index].used.store(false, std::memory_order_release);
+    }
+
+    // pin：读到的 epoch 写回之后全局 epoch 没变，才算进入
+    void enter() {
+        EpochDomain::Participant& p = domain->participants[index];
+        uint64_t epoch = domain->global_epoch.load(std::memory_order_seq_cst);
+        while (true) {
+            p.epoch.store(epoch, std::memory_order_seq_cst);
+            uint64_t now = domain->global_epoch.load(std::memory_order_seq_cst);
+            if (now == epoch) return;
+            epoch = now;
+        }
+    }
+
+    void leave() { domain->participants[index].epoch.store(0, std::memory_order_release); }
+
+    template <typename T>
+    void retire(const T* object) {
+        retired.push_back({object, [](const void* p) { delete static_cast<const T*>(p); },
+                           domain->global_epoch.load(std::memory_order_seq_cst), nullptr});
+        if (retired.size() >= COLLECT_THRESHOLD) collect();
+    }
+
+    // 尝试推进 epoch，释放已经安全的对象
+    void collect() {
+        domain->tryAdvance();
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (domain->reclaimable(retired[i].epoch)) {
+                retired[i].destroy(retired[i].object);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+        domain->collectOrphans();
+    }
+
+    size_t pendingRetired() const { return retired.size(); }
+};
+
+// 作用域内 pin 住，期间读到的指针保持有效
+class EpochGuard {
+private:
+    EpochHandle& handle;
+
+public:
+    explicit EpochGuard(EpochHandle& h) : handle(h) { handle.enter(); }
+    ~EpochGuard() { handle.leave(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+class SharedIncumbent {
+private:
+    EpochDomain domain_;
+    std::atomic<const CompactSolution*> current{nullptr};
+    std::atomic<int64_t> best_score{NO_INCUMBENT_SCORE};
+    std::atomic<uint64_t> published{0};
+
+public:
+    SharedIncumbent() = default;
+    SharedIncumbent(const SharedIncumbent&) = delete;
+    SharedIncumbent& operator=(const SharedIncumbent&) = delete;
+    ~SharedIncumbent() { delete current.load(); }
+
+    EpochDomain& domain() { return domain_; }
+
+    // 剪枝用：不需要 pin，可能比 current 稍晚更新，但只会单调下降
+    int64_t bestScore() const { return best_score.load(std::memory_order_acquire); }
+    bool improves(int64_t score) const { return score < bestScore(); }
+    uint64_t version() const { return published.load(std::memory_order_acquire); }
+
+    // 严格更好才替换，返回是否替换；被替换的旧方案交给 handle 延迟释放
+    bool publish(EpochHandle& handle, std::unique_ptr<CompactSolution> solution) {
+        int64_t score = solution->score();
+        if (!improves(score)) return false;
+
+        const CompactSolution* fresh = solution.release();
+        const CompactSolution* old;
+        bool installed = false;
+        {
+            // 比较 old 的分数时要 pin 住，old 可能正被别的线程退休
+            EpochGuard guard(handle);
+            old = current.load(std::memory_order_acquire);
+            while (!old || score < old->score()) {
+                if (current.compare_exchange_weak(old, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    installed = true;
+                    break;
+                }
+            }
+        }
+        if (!installed) {
+            delete fresh;
+            return false;
+        }
+
+        int64_t best = best_score.load(std::memory_order_relaxed);
+        while (score < best && !best_score.compare_exchange_weak(best, score, std::memory_order_acq_rel)) {}
+        published.fetch_add(1, std::memory_order_acq_rel);
+        if (old) handle.retire(old);
+        return true;
+    }
+
+    // 在 guard 的作用域内有效；还没有方案时返回 nullptr
+    const CompactSolution* load(const EpochGuard&) const { return current.load(std::memory_order_acquire); }
+
+    // 拷贝一份当前最优（从它重新出发时用），还没有方案时返回 false
+    bool snapshot(EpochHandle& handle, CompactSolution& out) const {
+        EpochGuard guard(handle);
+        const CompactSolution* solution = load(guard);
+        if (!solution) return false;
+        out = *solution;
+        return true;
+    }
+};
+
+#endif
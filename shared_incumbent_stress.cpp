@@ -0,0 +1,125 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+
+#include "shared_incumbent.h"
+
+using namespace std;
+
+// SharedIncumbent 和 epoch 回收的压力测试：多个线程同时发布、读取、拷贝当前最优，
+// 一部分线程反复创建和销毁 EpochHandle，让还没释放的退休对象走孤儿链表。
+// 每个方案的槽位都填成由分数算出的值，读到被释放或写了一半的方案就会校验失败；
+// 释放时机的错误由 ASan（释放后使用、泄漏）和 TSan（数据竞争）报告。
+// 构建并运行（两种 sanitizer 各跑一次）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address -pthread -o shared_incumbent_stress shared_incumbent_stress.cpp
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -o shared_incumbent_stress shared_incumbent_stress.cpp
+//   ./shared_incumbent_stress [threads] [iterations]
+
+const int ENGINEERS = 64;
+const int SLOTS = 5;
+
+static int32_t fillValue(const CompactSolution& solution, size_t i) {
+    return (int32_t)((solution.rest_days * 31 + solution.first14_missing * 7 + (long long)i) & 0x7FFFFFFF);
+}
+
+static unique_ptr<CompactSolution> makeSolution(int first14_missing, long long rest_days) {
+    unique_ptr<CompactSolution> solution(new CompactSolution());
+    solution->engineers = ENGINEERS;
+    solution->slots = SLOTS;
+    solution->first14_missing = first14_missing;
+    solution->rest_days = rest_days;
+    solution->slot_server.resize(ENGINEERS * SLOTS);
+    for (size_t i = 0; i < solution->slot_server.size(); i++) solution->slot_server[i] = fillValue(*solution, i);
+    return solution;
+}
+
+static bool consistent(const CompactSolution& solution) {
+    if (solution.engineers != ENGINEERS || solution.slots != SLOTS ||
+        solution.slot_server.size() != (size_t)ENGINEERS * SLOTS) {
+        return false;
+    }
+    for (size_t i = 0; i < solution.slot_server.size(); i++) {
+        if (solution.slot_server[i] != fillValue(solution, i)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? atoi(argv[1]) : 8;
+    int iterations = argc > 2 ? atoi(argv[2]) : 20000;
+
+    SharedIncumbent incumbent;
+    atomic<long long> installed{0}, failures{0}, reads{0};
+    atomic<int64_t> lowest{NO_INCUMBENT_SCORE};
+
+    auto worker = [&](int t) {
+        uint64_t state = 0x9E3779B97F4A7C15ULL * (t + 1);
+        auto next = [&]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+
+        // 奇数线程每 1000 次换一个 EpochHandle，析构时没释放的对象挂到孤儿链表上
+        unique_ptr<EpochHandle> handle(new EpochHandle(incumbent.domain()));
+        CompactSolution copy;
+        int64_t previous_best = NO_INCUMBENT_SCORE;
+        for (int k = 0; k < iterations; k++) {
+            if (t % 2 == 1 && k % 1000 == 999) handle.reset(new EpochHandle(incumbent.domain()));
+
+            switch (next() % 4) {
+                case 0: {
+                    // 分数整体随 k 下降，保证一直有新的方案被发布和退休
+                    int missing = next() % 3 == 0 ? 1 : 0;
+                    long long rest = (long long)(iterations - k) * 16 + (long long)(next() % 64);
+                    int64_t score = incumbentScore(missing, rest);
+                    if (incumbent.publish(*handle, makeSolution(missing, rest))) installed++;
+                    int64_t low = lowest.load();
+                    while (score < low && !lowest.compare_exchange_weak(low, score)) {}
+                    break;
+                }
+                case 1: {
+                    EpochGuard guard(*handle);
+                    const CompactSolution* solution = incumbent.load(guard);
+                    if (solution && !consistent(*solution)) failures++;
+                    reads++;
+                    break;
+                }
+                case 2:
+                    if (incumbent.snapshot(*handle, copy) && !consistent(copy)) failures++;
+                    reads++;
+                    break;
+                default: {
+                    // 最优分数只会单调下降
+                    int64_t best = incumbent.bestScore();
+                    if (best > previous_best) failures++;
+                    previous_best = best;
+                    break;
+                }
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker, t);
+    for (thread& th : pool) th.join();
+
+    {
+        EpochHandle handle(incumbent.domain());
+        EpochGuard guard(handle);
+        const CompactSolution* best = incumbent.load(guard);
+        if (!best || !consistent(*best) || best->score() != lowest.load() || incumbent.bestScore() != lowest.load()) {
+            failures++;
+        }
+    }
+    if ((long long)incumbent.version() != installed.load()) failures++;
+
+    cout << threads << " threads, " << iterations << " iterations each: " << installed.load() << " installed, "
+         << reads.load() << " reads, " << failures.load() << " failures" << endl;
+    return failures.load() == 0 ? 0 : 1;
+}
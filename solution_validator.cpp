@@ -0,0 +1,393 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+
+#include "alarm_index.h"
+#include "json_writer.h"
+
+using namespace std;
+
+// 独立的方案校验器：读取警报文件（使用位掩码索引）和任意 *_solution.txt，
+// 检查每个工程师最多 5 台服务器、每台服务器最多分配一次、编号在范围内、
+// 每个工程师前14天有工作以及总休息天数不超过上限（--max-rest-days -1 时不检查），
+// 并以 JSON 输出每个工程师的工作/休息天数。任何一条规则不满足都算无效，退出码为 2。
+//
+// 用法: solution_validator [options] ALARM_FILE SOLUTION_FILE [SOLUTION_FILE ...]
+
+const int DEFAULT_SLOTS = 5;
+const int DEFAULT_MAX_REST_DAYS = 410;
+const int MAX_REPORTED_ERRORS = 100;
+
+struct ValidatorConfig {
+    string alarm_file;
+    vector<string> solution_files;
+    int days = 0;          // 0 表示使用警报文件中的全部天数
+    int engineers = 0;     // 0 表示使用方案文件的行数
+    int servers = 0;       // 0 表示使用警报文件的服务器数量
+    int slots = DEFAULT_SLOTS;
+    int max_rest_days = DEFAULT_MAX_REST_DAYS;  // -1 表示不检查
+    bool per_engineer = true;
+    string output;
+};
+
+struct RuleError {
+    const char* rule;
+    int engineer;
+    long long server;
+};
+
+struct ValidationResult {
+    string solution_file;
+    bool readable = false;
+    int engineers = 0;
+    int lines = 0;
+    long long assigned = 0;
+
+    int slot_cap = 0;
+    int malformed = 0;
+    int out_of_range = 0;
+    int duplicates = 0;
+    int no_first14_work = 0;
+    int missing_engineers = 0;
+    int extra_engineers = 0;
+
+    long long total_rest_days = 0;
+    long long total_work_days = 0;
+    bool within_rest_limit = true;
+    bool valid = false;
+    double elapsed_ms = 0.0;
+
+    vector<RuleError> errors;
+    long long error_count = 0;
+
+    // 每个工程师的服务器（扁平存储）和工作天数
+    vector<int32_t> servers;
+    vector<int32_t> server_count;
+    vector<uint8_t> work_days;
+    vector<uint8_t> first14;
+};
+
+class SolutionValidator {
+private:
+    ValidatorConfig config;
+    AlarmIndex alarm_index;
+    int num_days = 0;
+    int num_servers = 0;
+    uint64_t horizon_mask = 0;
+    uint64_t first14_mask = 0;
+    vector<int32_t> owner;  // 复用的 server -> engineer 表
+
+public:
+    explicit SolutionValidator(const ValidatorConfig& cfg) : config(cfg) {}
+
+    bool loadAlarmData() {
+        if (!alarm_index.load(config.alarm_file, false)) {
+            return false;
+        }
+
+        num_days = config.days > 0 ? config.days : alarm_index.numDays();
+        if (num_days > alarm_index.numDays()) {
+            cerr << "Error: " << config.alarm_file << " has only " << alarm_index.numDays() << " days" << endl;
+            return false;
+        }
+        if (num_days > ALARM_INDEX_MASK_DAYS) {
+            cerr << "Error: validation uses 64-bit day masks, at most " << ALARM_INDEX_MASK_DAYS
+                 << " days are supported (use --days)" << endl;
+            return false;
+        }
+        num_servers = config.servers > 0 ? config.servers : alarm_index.numServers();
+        horizon_mask = num_days >= 64 ? ~0ULL : (1ULL << num_days) - 1;
+        first14_mask = alarm_index.first14Mask() & horizon_mask;
+        owner.assign(num_servers, -1);
+        return true;
+    }
+
+    int days() const { return num_days; }
+    int servers() const { return num_servers; }
+    const AlarmIndex& alarmIndex() const { return alarm_index; }
+
+    ValidationResult validate(const string& filename) {
+        auto start = chrono::steady_clock::now();
+        ValidationResult result;
+        result.solution_file = filename;
+
+        vector<char> text;
+        if (!readFile(filename, text)) {
+            cerr << "Error: Cannot open " << filename << endl;
+            return result;
+        }
+        result.readable = true;
+
+        // 按行解析：每行一个工程师，-1 表示空位，# 开头的行是注释
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end) {
+            const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (!line_end) line_end = end;
+            if (p < line_end && *p != '#') {
+                parseEngineer(p, line_end, result);
+            }
+            p = line_end + 1;
+        }
+
+        result.engineers = config.engineers > 0 ? config.engineers : result.lines;
+        if (result.lines < result.engineers) {
+            result.missing_engineers = result.engineers - result.lines;
+            result.server_count.resize(result.engineers, 0);
+        } else if (result.lines > result.engineers) {
+            result.extra_engineers = result.lines - result.engineers;
+            addError(result, "extra_engineers", result.engineers, -1);
+        }
+
+        // 用天掩码计算每个工程师的工作天数
+        result.work_days.assign(result.engineers, 0);
+        result.first14.assign(result.engineers, 0);
+        size_t offset = 0;
+        for (int e = 0; e < result.lines; e++) {
+            uint64_t mask = 0;
+            for (int i = 0; i < result.server_count[e]; i++) {
+                int32_t server = result.servers[offset + i];
+                if (server >= 0 && server < alarm_index.numServers()) mask |= alarm_index.mask(server);
+            }
+            offset += result.server_count[e];
+            if (e >= result.engineers) continue;
+
+            mask &= horizon_mask;
+            result.work_days[e] = __builtin_popcountll(mask);
+            result.first14[e] = (mask & first14_mask) != 0;
+        }
+
+        for (int e = 0; e < result.engineers; e++) {
+            result.total_work_days += result.work_days[e];
+            if (!result.first14[e]) {
+                result.no_first14_work++;
+                addError(result, "no_first14_work", e, -1);
+            }
+        }
+        result.total_rest_days = (long long)result.engineers * num_days - result.total_work_days;
+        result.within_rest_limit = config.max_rest_days < 0 || result.total_rest_days <= config.max_rest_days;
+        result.valid = result.slot_cap == 0 && result.malformed == 0 && result.out_of_range == 0 && result.duplicates == 0 &&
+                       result.no_first14_work == 0 && result.extra_engineers == 0 && result.within_rest_limit;
+
+        // 恢复 owner 表，下一个方案文件继续复用
+        for (int32_t server : result.servers) {
+            if (server >= 0 && server < num_servers) owner[server] = -1;
+        }
+
+        result.elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    static bool readFile(const string& filename, vector<char>& text) {
+        ifstream file(filename, ios::binary | ios::ate);
+        if (!file.is_open()) return false;
+        text.resize(file.tellg());
+        file.seekg(0);
+        return (bool)file.read(text.data(), text.size());
+    }
+
+    void parseEngineer(const char* p, const char* line_end, ValidationResult& result) {
+        int e = result.lines++;
+        int count = 0;
+
+        while (p < line_end) {
+            while (p < line_end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if (p >= line_end) break;
+
+            long long server;
+            auto [next, ec] = from_chars(p, line_end, server);
+            if (ec != errc()) {
+                result.malformed++;
+                addError(result, "malformed", e, -1);
+                break;
+            }
+            p = next;
+            if (server == -1) continue;
+
+            count++;
+            if (count == config.slots + 1) {
+                result.slot_cap++;
+                addError(result, "slot_cap", e, server);
+            }
+            if (server < 0 || server >= num_servers) {
+                result.out_of_range++;
+                addError(result, "out_of_range", e, server);
+                result.servers.push_back(-1);
+                continue;
+            }
+            if (owner[server] != -1) {
+                result.duplicates++;
+                addError(result, "duplicate", e, server);
+                result.servers.push_back(-1);
+                continue;
+            }
+            owner[server] = e;
+            result.servers.push_back(server);
+            result.assigned++;
+        }
+
+        result.server_count.push_back(count);
+    }
+
+    static void addError(ValidationResult& result, const char* rule, int engineer, long long server) {
+        result.error_count++;
+        if (result.errors.size() < MAX_REPORTED_ERRORS) {
+            result.errors.push_back({rule, engineer, server});
+        }
+    }
+};
+
+static void writeJson(string& out, const ValidatorConfig& config, const SolutionValidator& validator,
+                      const vector<ValidationResult>& results) {
+    out += "{\n  \"alarm_file\": ";
+    writeJsonString(out, config.alarm_file);
+    out += ",\n  \"days\": " + to_string(validator.days());
+    out += ",\n  \"servers\": " + to_string(validator.servers());
+    out += ",\n  \"slots\": " + to_string(config.slots);
+    out += ",\n  \"max_rest_days\": " + (config.max_rest_days < 0 ? string("null") : to_string(config.max_rest_days));
+    out += ",\n  \"solutions\": [";
+
+    for (size_t k = 0; k < results.size(); k++) {
+        const ValidationResult& r = results[k];
+        out += k == 0 ? "\n    {" : ",\n    {";
+        out += "\n      \"solution_file\": ";
+        writeJsonString(out, r.solution_file);
+        if (!r.readable) {
+            out += ",\n      \"readable\": false,\n      \"valid\": false\n    }";
+            continue;
+        }
+        out += ",\n      \"valid\": " + string(r.valid ? "true" : "false");
+        out += ",\n      \"engineers\": " + to_string(r.engineers);
+        out += ",\n      \"assigned_servers\": " + to_string(r.assigned);
+        out += ",\n      \"total_work_days\": " + to_string(r.total_work_days);
+        out += ",\n      \"total_rest_days\": " + to_string(r.total_rest_days);
+        out += ",\n      \"within_rest_limit\": " + string(r.within_rest_limit ? "true" : "false");
+        out += ",\n      \"violations\": {\"slot_cap\": " + to_string(r.slot_cap) +
+               ", \"malformed\": " + to_string(r.malformed) +
+               ", \"out_of_range\": " + to_string(r.out_of_range) +
+               ", \"duplicates\": " + to_string(r.duplicates) +
+               ", \"no_first14_work\": " + to_string(r.no_first14_work) +
+               ", \"missing_engineers\": " + to_string(r.missing_engineers) +
+               ", \"extra_engineers\": " + to_string(r.extra_engineers) + "}";
+
+        out += ",\n      \"error_count\": " + to_string(r.error_count);
+        out += ",\n      \"errors\": [";
+        for (size_t i = 0; i < r.errors.size(); i++) {
+            if (i > 0) out += ", ";
+            out += "{\"rule\": \"" + string(r.errors[i].rule) + "\", \"engineer\": " + to_string(r.errors[i].engineer);
+            if (r.errors[i].server != -1) out += ", \"server\": " + to_string(r.errors[i].server);
+            out += "}";
+        }
+        out += "]";
+
+        if (config.per_engineer) {
+            // 每个工程师一行: [工作天数, 休息天数, 前14天是否有工作]
+            out += ",\n      \"per_engineer\": {\"fields\": [\"work\", \"rest\", \"first14\"], \"values\": [";
+            for (int e = 0; e < r.engineers; e++) {
+                out += e == 0 ? "\n        [" : ",\n        [";
+                out += to_string(r.work_days[e]) + ", " + to_string(validator.days() - r.work_days[e]) + ", " +
+                       (r.first14[e] ? "true" : "false") + "]";
+            }
+            out += "\n      ]}";
+        }
+
+        char elapsed[32];
+        snprintf(elapsed, sizeof(elapsed), "%.3f", r.elapsed_ms);
+        out += ",\n      \"elapsed_ms\": " + string(elapsed);
+        out += "\n    }";
+    }
+
+    out += "\n  ]\n}\n";
+}
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options] ALARM_FILE SOLUTION_FILE [SOLUTION_FILE ...]" << endl;
+    cout << "  --days N             只检查前 N 天 (默认使用警报文件的全部天数)" << endl;
+    cout << "  --engineers N        工程师数量 (默认使用方案文件的行数)" << endl;
+    cout << "  --servers N          服务器数量 (默认使用警报文件的服务器数量)" << endl;
+    cout << "  --slots N            每个工程师最多负责的服务器 (默认 " << DEFAULT_SLOTS << ")" << endl;
+    cout << "  --max-rest-days N    总休息天数上限，-1 表示不检查 (默认 " << DEFAULT_MAX_REST_DAYS << ")" << endl;
+    cout << "  --summary            不输出每个工程师的工作/休息天数" << endl;
+    cout << "  --out FILE           JSON 输出文件 (默认标准输出)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    ValidatorConfig config;
+    vector<string> positional;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (arg == "--summary") {
+            config.per_engineer = false;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--days") config.days = stoi(value);
+        else if (arg == "--engineers") config.engineers = stoi(value);
+        else if (arg == "--servers") config.servers = stoi(value);
+        else if (arg == "--slots") config.slots = stoi(value);
+        else if (arg == "--max-rest-days") config.max_rest_days = stoi(value);
+        else if (arg == "--out") config.output = value;
+        else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (positional.size() < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    config.alarm_file = positional[0];
+    config.solution_files.assign(positional.begin() + 1, positional.end());
+
+    SolutionValidator validator(config);
+    if (!validator.loadAlarmData()) {
+        return 1;
+    }
+
+    vector<ValidationResult> results;
+    bool all_valid = true;
+    for (const string& filename : config.solution_files) {
+        results.push_back(validator.validate(filename));
+        all_valid = all_valid && results.back().valid;
+    }
+
+    string json;
+    writeJson(json, config, validator, results);
+    if (config.output.empty()) {
+        fwrite(json.data(), 1, json.size(), stdout);
+    } else {
+        ofstream file(config.output);
+        if (!file.is_open()) {
+            cerr << "Error: Cannot create " << config.output << endl;
+            return 1;
+        }
+        file << json;
+    }
+
+    return all_valid ? 0 : 2;
+}
@@ -0,0 +1,195 @@
+#ifndef SOLVER_CORE_H
+#define SOLVER_CORE_H
+
+// 所有求解策略共用的核心：问题常量、方案结构、警报数据模型、方案评估和方案文件读写。
+//
+// 数据只在这里加载一次（AlarmIndex 快照 + 按天/按服务器的列表），策略通过
+// const ProblemData& 使用，不再各自解析 alarm_list.txt 或重新声明 Solution。
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "alarm_index.h"
+#include "perf_counters.h"
+
+const int NUM_ENGINEERS = 336;
+const int NUM_SERVERS = 1620;
+const int MAX_SERVERS_PER_ENGINEER = 5;
+const int MAX_REST_DAYS = 410;
+const int FIRST_14_DAYS = 14;
+const int DEFAULT_NUM_DAYS = 22;  // 固定周期策略使用的规划天数
+
+struct Solution {
+    std::vector<std::vector<int>> allocation;  // allocation[engineer][slot] = server，空位为 -1
+    std::vector<std::vector<bool>> daily_work; // daily_work[engineer][day] = true 表示当天工作
+    int total_rest_days;
+    int num_days;
+    bool valid;
+
+    explicit Solution(int days = 0)
+        : allocation(NUM_ENGINEERS, std::vector<int>(MAX_SERVERS_PER_ENGINEER, -1)),
+          daily_work(NUM_ENGINEERS, std::vector<bool>(days, false)),
+          total_rest_days(0), num_days(days), valid(false) {}
+
+    // 清空所有工程师的服务器列表，供逐个 push_back 再补 -1 的构造方式使用
+    void clearAllocation() {
+        for (auto& servers : allocation) servers.clear();
+    }
+};
+
+// 规划周期内的警报数据
+struct ProblemData {
+    AlarmIndex alarm_index;
+    int num_days = 0;
+    std::vector<std::vector<int>> daily_alarms;    // daily_alarms[day] = 当天报警的服务器
+    std::map<int, std::vector<int>> server_to_days; // 有报警的服务器 -> 报警的天（升序）
+
+    // horizon 为 0 时使用警报文件中的全部天数，否则截取前 horizon 天。
+    // 编号超出 NUM_SERVERS 的服务器不在分配范围内，直接忽略
+    bool load(const std::string& filename, int horizon = 0) {
+        if (!alarm_index.load(filename)) {
+            return false;
+        }
+
+        PerfScope build_scope(PERF_INDEX_BUILD);
+        num_days = horizon > 0 ? std::min(alarm_index.numDays(), horizon) : alarm_index.numDays();
+        daily_alarms.assign(num_days, std::vector<int>());
+        server_to_days.clear();
+
+        for (int day = 0; day < num_days; day++) {
+            for (const int32_t* it = alarm_index.dayBegin(day); it != alarm_index.dayEnd(day); ++it) {
+                if (*it < NUM_SERVERS) {
+                    daily_alarms[day].push_back(*it);
+                    server_to_days[*it].push_back(day);
+                }
+            }
+        }
+
+        if (horizon > 0 && num_days < horizon) {
+            std::cerr << "Warning: " << filename << " has only " << num_days << " of " << horizon
+                      << " planning days" << std::endl;
+        }
+        return true;
+    }
+
+    // 服务器的报警天（没有报警时为空）
+    const std::vector<int>& serverDays(int server) const {
+        static const std::vector<int> none;
+        auto it = server_to_days.find(server);
+        return it == server_to_days.end() ? none : it->second;
+    }
+};
+
+// 方案评估结果
+struct SolutionReport {
+    int total_rest_days = 0;
+    int engineers_with_first_14_work = 0;
+    int assigned_servers = 0;
+    std::map<int, int> work_days_distribution;
+    std::map<int, int> rest_days_distribution;
+    bool valid = false;
+};
+
+// 按警报数据重新计算每日工作情况、总休息天数和约束是否满足，结果同时写回 solution
+inline SolutionReport evaluateSolution(const ProblemData& data, Solution& solution) {
+    PerfScope scope(PERF_VALIDATION);
+    SolutionReport report;
+    solution.num_days = data.num_days;
+    solution.daily_work.assign(NUM_ENGINEERS, std::vector<bool>(data.num_days, false));
+
+    for (int engineer = 0; engineer < NUM_ENGINEERS && engineer < (int)solution.allocation.size(); engineer++) {
+        for (int server : solution.allocation[engineer]) {
+            if (server < 0) continue;
+            report.assigned_servers++;
+            for (int day : data.serverDays(server)) {
+                solution.daily_work[engineer][day] = true;
+            }
+        }
+    }
+
+    for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
+        int work_days = 0;
+        bool has_first_14_work = false;
+        for (int day = 0; day < data.num_days; day++) {
+            if (solution.daily_work[engineer][day]) {
+                work_days++;
+                if (day < FIRST_14_DAYS) has_first_14_work = true;
+            }
+        }
+
+        report.total_rest_days += data.num_days - work_days;
+        report.work_days_distribution[work_days]++;
+        report.rest_days_distribution[data.num_days - work_days]++;
+        if (has_first_14_work) report.engineers_with_first_14_work++;
+    }
+
+    report.valid = report.total_rest_days <= MAX_REST_DAYS && report.engineers_with_first_14_work == NUM_ENGINEERS;
+    solution.total_rest_days = report.total_rest_days;
+    solution.valid = report.valid;
+    return report;
+}
+
+inline void printSolutionReport(const SolutionReport& report) {
+    std::cout << "\n=== Final Results ===" << std::endl;
+    std::cout << "Work days distribution:" << std::endl;
+    for (auto& [days, count] : report.work_days_distribution) {
+        std::cout << "  " << count << " engineers work " << days << " days" << std::endl;
+    }
+
+    std::cout << "\nRest days distribution:" << std::endl;
+    for (auto& [days, count] : report.rest_days_distribution) {
+        std::cout << "  " << count << " engineers rest " << days << " days" << std::endl;
+    }
+
+    std::cout << "\nConstraint Check:" << std::endl;
+    std::cout << "Total rest days: " << report.total_rest_days << " / " << MAX_REST_DAYS;
+    if (report.total_rest_days <= MAX_REST_DAYS) {
+        std::cout << " ✓ SATISFIED" << std::endl;
+    } else {
+        std::cout << " ✗ VIOLATED (excess: " << (report.total_rest_days - MAX_REST_DAYS) << ")" << std::endl;
+    }
+
+    std::cout << "Engineers with first 14 days work: " << report.engineers_with_first_14_work << " / " << NUM_ENGINEERS;
+    if (report.engineers_with_first_14_work == NUM_ENGINEERS) {
+        std::cout << " ✓ SATISFIED" << std::endl;
+    } else {
+        std::cout << " ✗ VIOLATED (missing: " << (NUM_ENGINEERS - report.engineers_with_first_14_work) << ")" << std::endl;
+    }
+
+    std::cout << "Assigned servers: " << report.assigned_servers << " / " << NUM_SERVERS << std::endl;
+    std::cout << "Average rest days per engineer: " << (double)report.total_rest_days / NUM_ENGINEERS << std::endl;
+
+    if (report.valid) {
+        std::cout << "\n*** ALL CONSTRAINTS SATISFIED! ***" << std::endl;
+    } else {
+        std::cout << "\n*** CONSTRAINT VIOLATIONS DETECTED ***" << std::endl;
+    }
+}
+
+// 每行一个工程师，MAX_SERVERS_PER_ENGINEER 个服务器编号，空位为 -1
+inline bool saveSolution(const Solution& solution, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create " << filename << std::endl;
+        return false;
+    }
+
+    for (int e = 0; e < NUM_ENGINEERS; e++) {
+        for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
+            int server = i < (int)solution.allocation[e].size() ? solution.allocation[e][i] : -1;
+            file << server;
+            if (i < MAX_SERVERS_PER_ENGINEER - 1) file << " ";
+        }
+        file << std::endl;
+    }
+
+    file.close();
+    std::cout << "Solution saved to " << filename << std::endl;
+    return true;
+}
+
+#endif
@@ -0,0 +1,634 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "alarm_index.h"
+#include "allocation_state.h"
+#include "local_search.h"
+#include "what_if.h"
+#include "json_writer.h"
+
+using namespace std;
+
+// 常驻的求解服务：在 Unix 域套接字上接收请求，警报索引和当前最优方案常驻内存，
+// 请求放进工作线程池执行，每个请求带截止时间。
+//
+// 协议是按行的文本，每个请求一行，每个响应是一行 JSON：
+//   PING
+//   STATS
+//   EVAL s0 s1 ... s(engineers*slots-1)   评估一个完整方案（按工程师顺序，-1 为空位）
+//   WHATIF RELOCATE server engineer       把服务器转给工程师后的变化（不修改当前方案）
+//   WHATIF SWAP server1 server2           交换两台服务器的负责人后的变化
+//   WHATIF BATCH R s e S s1 s2 ...        一次评估多个互相独立的移动
+//   SOLVE budget_ms                       在当前方案上做修复 + 局部搜索，变好则替换
+//   GET                                   返回当前方案
+//   SAVE file                             把当前方案写入文件
+//   RELOAD                                重新加载警报文件（内容没变时直接复用快照）
+// 任何请求都可以附加 deadline=MS，覆盖默认的截止时间。截止时间之前还没开始执行的请求
+// 被拒绝；已经开始的请求照常完成（SOLVE 的搜索时间不超过剩余时间），SOLVE 的响应
+// 报告替换之后当前方案的 rest_days / first14_missing。
+
+const int DEFAULT_ENGINEERS = 336;
+const int DEFAULT_SLOTS = 5;
+const double DEFAULT_DEADLINE_MS = 1000.0;
+
+struct DaemonConfig {
+    string alarm_file = "alarm_list.txt";
+    string socket_path = "solver.sock";
+    string initial;
+    int engineers = DEFAULT_ENGINEERS;
+    int servers = 0;   // 0 表示使用警报文件的服务器数量
+    int slots = DEFAULT_SLOTS;
+    int days = 0;      // 0 表示使用警报文件的全部天数
+    int workers = 0;   // 0 表示使用硬件线程数
+    double deadline_ms = DEFAULT_DEADLINE_MS;
+};
+
+typedef chrono::steady_clock Clock;
+
+struct Job {
+    string request;
+    Clock::time_point received;
+    Clock::time_point deadline;
+    promise<string> response;
+};
+
+// 错误信息里可能带有客户端发来的原样内容，必须转义才能保证每行响应是合法 JSON
+static string jsonError(const string& message) {
+    string out = "{\"ok\": false, \"error\": ";
+    writeJsonString(out, message);
+    return out + "}";
+}
+
+static bool parseInt(const string& token, long long& value) {
+    auto [ptr, ec] = from_chars(token.data(), token.data() + token.size(), value);
+    return ec == errc() && ptr == token.data() + token.size();
+}
+
+class WorkerPool {
+private:
+    mutex queue_mutex;
+    condition_variable queue_cv;
+    deque<shared_ptr<Job>> queue;
+    vector<thread> threads;
+    bool stopping = false;
+
+public:
+    template <typename Handler>
+    void start(int count, Handler handler) {
+        for (int i = 0; i < count; i++) {
+            threads.emplace_back([this, handler]() {
+                while (true) {
+                    shared_ptr<Job> job;
+                    {
+                        unique_lock<mutex> lock(queue_mutex);
+                        queue_cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+                        if (queue.empty()) return;
+                        job = queue.front();
+                        queue.pop_front();
+                    }
+                    job->response.set_value(handler(*job));
+                }
+            });
+        }
+    }
+
+    void submit(const shared_ptr<Job>& job) {
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            queue.push_back(job);
+        }
+        queue_cv.notify_one();
+    }
+
+    size_t pending() {
+        lock_guard<mutex> lock(queue_mutex);
+        return queue.size();
+    }
+
+    void stop() {
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            stopping = true;
+        }
+        queue_cv.notify_all();
+        for (auto& t : threads) t.join();
+        threads.clear();
+    }
+};
+
+// 一个客户端连接和服务它的线程。fd 在线程结束时由线程自己关闭，关闭之前停止服务时
+// 可以用 shutdown 打断阻塞的 read
+struct Connection {
+    int fd = -1;
+    thread worker;
+    atomic<bool> done{false};
+};
+
+class SolverDaemon {
+private:
+    DaemonConfig config;
+
+    // index、neighbors 和 incumbent 受 state_mutex 保护；SOLVE 在副本上搜索，只在替换时加写锁
+    shared_mutex state_mutex;
+    shared_ptr<AlarmIndex> index;
+    shared_ptr<NeighborLists> neighbors;  // 只取决于服务器掩码，每次载入索引建一次，SOLVE 复用
+    AllocationState incumbent;
+    int num_days = 0;
+    int num_servers = 0;
+    uint64_t version = 0;
+
+    WorkerPool pool;
+    int listen_fd = -1;
+    mutex connections_mutex;                  // 保护各连接的 fd：关闭和 shutdown 不能交错
+    vector<unique_ptr<Connection>> connections; // 只由 run 的线程增删
+
+    atomic<long long> requests{0};
+    atomic<long long> rejected{0};
+    atomic<long long> total_micros{0};
+
+public:
+    explicit SolverDaemon(const DaemonConfig& cfg) : config(cfg) {}
+
+    bool initialize() {
+        if (!loadIndex()) return false;
+
+        if (!config.initial.empty()) {
+            vector<vector<int>> allocation;
+            if (!loadAllocationFile(config.initial, config.slots, allocation)) return false;
+            RepairReport report = incumbent.assignFrom(allocation);
+            cout << "Loaded initial allocation " << config.initial << " (dropped "
+                 << report.out_of_range + report.duplicates + report.overflow << " entries), rest days "
+                 << incumbent.total_rest_days << endl;
+        }
+        return true;
+    }
+
+    bool listenOn(const string& path) {
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            perror("socket");
+            return false;
+        }
+
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            cerr << "Error: Socket path too long: " << path << endl;
+            return false;
+        }
+        strcpy(addr.sun_path, path.c_str());
+        unlink(path.c_str());
+
+        if (bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 64) != 0) {
+            perror("bind");
+            return false;
+        }
+        return true;
+    }
+
+    void run(const atomic<bool>& stop) {
+        int workers = config.workers > 0 ? config.workers : max(1u, thread::hardware_concurrency());
+        pool.start(workers, [this](Job& job) { return handle(job); });
+        cout << "Listening on " << config.socket_path << " with " << workers << " workers" << endl;
+
+        while (!stop) {
+            pollfd pfd = {listen_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 200) <= 0) continue;
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) continue;
+            reapConnections();
+
+            auto connection = make_unique<Connection>();
+            Connection* c = connection.get();
+            c->fd = fd;
+            c->worker = thread([this, c]() {
+                serveConnection(c->fd);
+                {
+                    lock_guard<mutex> lock(connections_mutex);
+                    close(c->fd);
+                    c->fd = -1;
+                }
+                c->done = true;
+            });
+            connections.push_back(move(connection));
+        }
+
+        // 先让所有连接线程结束，再停线程池：正在服务的连接可能还要 submit 并等待结果。
+        // 只关读方向，阻塞的 read 返回 0，正在执行的请求仍然能写回响应
+        {
+            lock_guard<mutex> lock(connections_mutex);
+            for (auto& c : connections) {
+                if (c->fd >= 0) shutdown(c->fd, SHUT_RD);
+            }
+        }
+        for (auto& c : connections) c->worker.join();
+        connections.clear();
+        pool.stop();
+        close(listen_fd);
+        unlink(config.socket_path.c_str());
+    }
+
+private:
+    // 回收已经结束的连接线程，长时间运行的守护进程不会积累线程句柄
+    void reapConnections() {
+        auto finished = stable_partition(connections.begin(), connections.end(),
+                                         [](const unique_ptr<Connection>& c) { return !c->done; });
+        for (auto it = finished; it != connections.end(); ++it) (*it)->worker.join();
+        connections.erase(finished, connections.end());
+    }
+
+    bool loadIndex() {
+        auto fresh = make_shared<AlarmIndex>();
+        if (!fresh->load(config.alarm_file)) return false;
+
+        int days = config.days > 0 ? min(config.days, fresh->numDays()) : fresh->numDays();
+        if (days > ALARM_INDEX_MASK_DAYS) {
+            cerr << "Error: the daemon uses 64-bit day masks, at most " << ALARM_INDEX_MASK_DAYS
+                 << " days are supported (use --days)" << endl;
+            return false;
+        }
+        int servers = config.servers > 0 ? config.servers : fresh->numServers();
+
+        // 新索引生效时，把当前方案按新的掩码重新装入
+        vector<vector<int>> allocation;
+        bool had_incumbent = index != nullptr;
+        if (had_incumbent) allocation = incumbent.toAllocation();
+
+        incumbent.reset(*fresh, config.engineers, servers, config.slots, days);
+        if (had_incumbent) incumbent.assignFrom(allocation);
+
+        auto lists = make_shared<NeighborLists>();
+        if (servers >= NEIGHBOR_LIST_MIN_SERVERS) {
+            auto start = Clock::now();
+            lists->build(incumbent, solverPool().concurrency());
+            cout << "Built neighbor lists for " << servers << " servers ("
+                 << chrono::duration<double, milli>(Clock::now() - start).count() << " ms)" << endl;
+        }
+        neighbors = lists;
+
+        index = fresh;
+        num_days = days;
+        num_servers = servers;
+        version++;
+        return true;
+    }
+
+    // 一个连接一个线程：按行读取请求，交给线程池执行，按顺序写回响应。
+    // 连接断开或被 shutdown 时返回，fd 由调用方关闭
+    void serveConnection(int fd) {
+        string buffer;
+        char chunk[65536];
+        while (true) {
+            size_t newline;
+            while ((newline = buffer.find('\n')) == string::npos) {
+                ssize_t n = read(fd, chunk, sizeof(chunk));
+                if (n <= 0) return;
+                buffer.append(chunk, n);
+            }
+
+            auto job = make_shared<Job>();
+            job->request = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!job->request.empty() && job->request.back() == '\r') job->request.pop_back();
+            if (job->request.empty()) continue;
+
+            job->received = Clock::now();
+            job->deadline = job->received + chrono::microseconds((long long)(requestDeadlineMs(job->request) * 1000));
+
+            future<string> response = job->response.get_future();
+            pool.submit(job);
+            string reply = response.get() + "\n";
+
+            if (write(fd, reply.data(), reply.size()) != (ssize_t)reply.size()) return;
+        }
+    }
+
+    double requestDeadlineMs(const string& request) const {
+        size_t pos = request.find("deadline=");
+        if (pos == string::npos) return config.deadline_ms;
+        return atof(request.c_str() + pos + 9);
+    }
+
+    // 截止时间只在开始执行前检查：排队期间已经超时的请求直接拒绝；一旦开始执行，
+    // SOLVE / RELOAD 可能已经修改了状态，响应总是报告真实结果
+    string handle(Job& job) {
+        if (Clock::now() > job.deadline) {
+            rejected++;
+            return jsonError("deadline exceeded before start");
+        }
+
+        istringstream iss(job.request);
+        vector<string> tokens;
+        string token;
+        while (iss >> token) {
+            if (token.rfind("deadline=", 0) != 0) tokens.push_back(token);
+        }
+
+        string response;
+        if (tokens.empty()) {
+            response = jsonError("empty request");
+        } else if (tokens[0] == "PING") {
+            response = "{\"ok\": true}";
+        } else if (tokens[0] == "STATS") {
+            response = handleStats();
+        } else if (tokens[0] == "EVAL") {
+            response = handleEval(tokens);
+        } else if (tokens[0] == "WHATIF") {
+            response = handleWhatIf(tokens);
+        } else if (tokens[0] == "SOLVE") {
+            response = handleSolve(tokens, job.deadline);
+        } else if (tokens[0] == "GET") {
+            response = handleGet();
+        } else if (tokens[0] == "SAVE") {
+            response = handleSave(tokens);
+        } else if (tokens[0] == "RELOAD") {
+            unique_lock<shared_mutex> lock(state_mutex);
+            response = loadIndex() ? "{\"ok\": true, \"version\": " + to_string(version) + "}"
+                                   : jsonError("cannot load " + config.alarm_file);
+        } else {
+            response = jsonError("unknown command " + tokens[0]);
+        }
+
+        long long micros = chrono::duration_cast<chrono::microseconds>(Clock::now() - job.received).count();
+        requests++;
+        total_micros += micros;
+        return response;
+    }
+
+    string handleStats() {
+        shared_lock<shared_mutex> lock(state_mutex);
+        long long served = requests.load();
+        ostringstream oss;
+        oss << "{\"ok\": true, \"engineers\": " << config.engineers << ", \"servers\": " << num_servers
+            << ", \"slots\": " << config.slots << ", \"days\": " << num_days
+            << ", \"rest_days\": " << incumbent.total_rest_days
+            << ", \"first14_missing\": " << incumbent.first14_missing
+            << ", \"version\": " << version
+            << ", \"index_from_snapshot\": " << (index->loadedFromSnapshot() ? "true" : "false")
+            << ", \"requests\": " << served << ", \"deadline_exceeded\": " << rejected.load()
+            << ", \"avg_latency_us\": " << (served ? total_micros.load() / served : 0)
+            << ", \"queued\": " << pool.pending() << "}";
+        return oss.str();
+    }
+
+    // 只做掩码 OR 和计数，不修改当前方案
+    string handleEval(const vector<string>& tokens) {
+        shared_lock<shared_mutex> lock(state_mutex);
+        size_t expected = (size_t)config.engineers * config.slots;
+        if (tokens.size() - 1 != expected) {
+            return jsonError("EVAL expects " + to_string(expected) + " server IDs");
+        }
+
+        // 每个线程复用一张带代数标记的 server 表，避免每次清零
+        thread_local vector<uint32_t> seen;
+        thread_local uint32_t generation = 0;
+        if ((int)seen.size() != num_servers) {
+            seen.assign(num_servers, 0);
+            generation = 0;
+        }
+        generation++;
+
+        uint64_t horizon = incumbent.horizon_mask;
+        long long work_days = 0;
+        int first14_missing = 0, duplicates = 0, out_of_range = 0;
+        for (int e = 0; e < config.engineers; e++) {
+            uint64_t mask = 0;
+            for (int i = 0; i < config.slots; i++) {
+                long long server;
+                if (!parseInt(tokens[1 + (size_t)e * config.slots + i], server)) {
+                    return jsonError("malformed server ID");
+                }
+                if (server == -1) continue;
+                if (server < 0 || server >= num_servers) {
+                    out_of_range++;
+                    continue;
+                }
+                if (seen[server] == generation) {
+                    duplicates++;
+                    continue;
+                }
+                seen[server] = generation;
+                mask |= incumbent.serverMask(server);
+            }
+            mask &= horizon;
+            work_days += __builtin_popcountll(mask);
+            if (!(mask & incumbent.first14_mask)) first14_missing++;
+        }
+
+        long long rest_days = (long long)config.engineers * num_days - work_days;
+        ostringstream oss;
+        oss << "{\"ok\": true, \"valid\": " << (first14_missing == 0 && duplicates == 0 && out_of_range == 0 ? "true" : "false")
+            << ", \"rest_days\": " << rest_days << ", \"first14_missing\": " << first14_missing
+            << ", \"duplicates\": " << duplicates << ", \"out_of_range\": " << out_of_range
+            << ", \"incumbent_rest_days\": " << incumbent.total_rest_days << "}";
+        return oss.str();
+    }
+
+    // WHATIF RELOCATE server engineer | WHATIF SWAP server1 server2 |
+    // WHATIF BATCH R server engineer S server1 server2 ...（批量查询互相独立）
+    string handleWhatIf(const vector<string>& tokens) {
+        vector<WhatIfMove> moves;
+        bool batch = tokens.size() > 1 && tokens[1] == "BATCH";
+        size_t k = batch ? 2 : 1;
+        while (k < tokens.size()) {
+            long long a, b;
+            if (k + 2 >= tokens.size() || !parseInt(tokens[k + 1], a) || !parseInt(tokens[k + 2], b)) {
+                return jsonError("usage: WHATIF RELOCATE server engineer | WHATIF SWAP server1 server2 | WHATIF BATCH ...");
+            }
+            const string& kind = tokens[k];
+            if (kind == "RELOCATE" || kind == "R") moves.push_back({WHATIF_RELOCATE, (int32_t)a, (int32_t)b});
+            else if (kind == "SWAP" || kind == "S") moves.push_back({WHATIF_SWAP, (int32_t)a, (int32_t)b});
+            else return jsonError("unknown WHATIF move " + kind);
+            k += 3;
+            if (!batch) break;
+        }
+        if (moves.empty() || (!batch && k != tokens.size())) {
+            return jsonError("usage: WHATIF RELOCATE server engineer | WHATIF SWAP server1 server2 | WHATIF BATCH ...");
+        }
+
+        shared_lock<shared_mutex> lock(state_mutex);
+        WhatIfEvaluator evaluator(incumbent);
+        vector<WhatIfResult> results = evaluator.evaluateBatch(moves);
+
+        if (!batch) return whatIfJson(results[0]);
+        string out = "{\"ok\": true, \"results\": [";
+        for (size_t i = 0; i < results.size(); i++) {
+            if (i > 0) out += ", ";
+            out += whatIfJson(results[i]);
+        }
+        return out + "]}";
+    }
+
+    string whatIfJson(const WhatIfResult& result) {
+        if (!result.ok()) return jsonError(whatIfStatusName(result.status));
+        int first14_missing = incumbent.first14_missing + result.first14_delta;
+        return "{\"ok\": true, \"rest_delta\": " + to_string(result.rest_delta) +
+               ", \"rest_days\": " + to_string(incumbent.total_rest_days + result.rest_delta) +
+               ", \"first14_ok\": " + (first14_missing == 0 ? "true" : "false") +
+               ", \"first14_missing\": " + to_string(first14_missing) + "}";
+    }
+
+    string handleSolve(const vector<string>& tokens, Clock::time_point deadline) {
+        long long budget_ms;
+        if (tokens.size() != 2 || !parseInt(tokens[1], budget_ms) || budget_ms < 0) {
+            return jsonError("usage: SOLVE budget_ms");
+        }
+
+        // 在副本上搜索，持有索引和邻居表的 shared_ptr，避免搜索期间 RELOAD 释放它们
+        shared_ptr<AlarmIndex> search_index;
+        shared_ptr<NeighborLists> search_neighbors;
+        AllocationState candidate;
+        uint64_t base_version;
+        {
+            shared_lock<shared_mutex> lock(state_mutex);
+            search_index = index;
+            search_neighbors = neighbors;
+            candidate = incumbent;
+            base_version = version;
+        }
+
+        // 预算同时作为所有阶段的截止时间，修复和填充也不会让请求超时
+        Clock::time_point now = Clock::now();
+        double remaining = chrono::duration<double>(deadline - now).count();
+        double budget = max(0.0, min(budget_ms / 1000.0, remaining * 0.9));
+        Clock::time_point search_deadline = now + chrono::duration_cast<Clock::duration>(chrono::duration<double>(budget));
+        LocalSearchStats stats = repairAndImproveWith(candidate, budget, search_neighbors.get(), search_deadline);
+
+        bool improved = false;
+        long long rest_days;
+        int first14_missing;
+        {
+            unique_lock<shared_mutex> lock(state_mutex);
+            bool better = candidate.first14_missing < incumbent.first14_missing ||
+                          (candidate.first14_missing == incumbent.first14_missing &&
+                           candidate.total_rest_days < incumbent.total_rest_days);
+            if (base_version == version && better) {
+                incumbent = candidate;
+                version++;
+                improved = true;
+            }
+            rest_days = incumbent.total_rest_days;
+            first14_missing = incumbent.first14_missing;
+        }
+
+        ostringstream oss;
+        oss << "{\"ok\": true, \"improved\": " << (improved ? "true" : "false")
+            << ", \"rest_days\": " << rest_days << ", \"first14_missing\": " << first14_missing
+            << ", \"moves\": " << stats.sweep_moves + stats.moves << ", \"seconds\": " << stats.seconds << "}";
+        return oss.str();
+    }
+
+    string handleGet() {
+        shared_lock<shared_mutex> lock(state_mutex);
+        string out = "{\"ok\": true, \"version\": " + to_string(version) + ", \"allocation\": [";
+        for (size_t i = 0; i < incumbent.slot_server.size(); i++) {
+            if (i > 0) out += ",";
+            out += to_string(incumbent.slot_server[i]);
+        }
+        return out + "]}";
+    }
+
+    string handleSave(const vector<string>& tokens) {
+        if (tokens.size() != 2) return jsonError("usage: SAVE file");
+        shared_lock<shared_mutex> lock(state_mutex);
+        ofstream file(tokens[1]);
+        if (!file.is_open()) return jsonError("cannot create " + tokens[1]);
+        for (int e = 0; e < config.engineers; e++) {
+            for (int i = 0; i < config.slots; i++) {
+                file << incumbent.slotServer(e, i);
+                if (i < config.slots - 1) file << " ";
+            }
+            file << "\n";
+        }
+        return "{\"ok\": true}";
+    }
+};
+
+static atomic<bool> stop_requested{false};
+
+static void handleSignal(int) {
+    stop_requested = true;
+}
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]" << endl;
+    cout << "  --alarms FILE        警报文件 (默认 alarm_list.txt)" << endl;
+    cout << "  --socket PATH        Unix 域套接字路径 (默认 solver.sock)" << endl;
+    cout << "  --initial FILE       初始分配方案 (默认为空)" << endl;
+    cout << "  --engineers N        工程师数量 (默认 " << DEFAULT_ENGINEERS << ")" << endl;
+    cout << "  --servers N          服务器数量 (默认使用警报文件的服务器数量)" << endl;
+    cout << "  --slots N            每个工程师最多负责的服务器 (默认 " << DEFAULT_SLOTS << ")" << endl;
+    cout << "  --days N             天数 (默认使用警报文件的全部天数)" << endl;
+    cout << "  --workers N          工作线程数 (默认硬件线程数)" << endl;
+    cout << "  --deadline-ms MS     默认请求截止时间 (默认 " << DEFAULT_DEADLINE_MS << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    DaemonConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: Missing value for " << arg << endl;
+            return 1;
+        }
+        string value = argv[++i];
+
+        if (arg == "--alarms") config.alarm_file = value;
+        else if (arg == "--socket") config.socket_path = value;
+        else if (arg == "--initial") config.initial = value;
+        else if (arg == "--engineers") config.engineers = stoi(value);
+        else if (arg == "--servers") config.servers = stoi(value);
+        else if (arg == "--slots") config.slots = stoi(value);
+        else if (arg == "--days") config.days = stoi(value);
+        else if (arg == "--workers") config.workers = stoi(value);
+        else if (arg == "--deadline-ms") config.deadline_ms = stod(value);
+        else {
+            cerr << "Error: Unknown option " << arg << endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    cout << "=== Solver Daemon ===" << endl;
+    SolverDaemon daemon(config);
+    if (!daemon.initialize() || !daemon.listenOn(config.socket_path)) {
+        return 1;
+    }
+
+    daemon.run(stop_requested);
+    cout << "Solver daemon stopped" << endl;
+    return 0;
+}
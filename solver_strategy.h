@@ -0,0 +1,84 @@
+#ifndef SOLVER_STRATEGY_H
+#define SOLVER_STRATEGY_H
+
+// 求解策略的公共接口和注册表。
+//
+// 每个算法是一个 SolverStrategy 子类，在自己的 .cpp 里用 REGISTER_SOLVER_STRATEGY
+// 注册；main.cpp 是唯一的入口，按 --strategy 名字（或可执行文件名）选择策略。
+// 只链接了一个策略的程序默认使用该策略，因此仍可以构建单算法的可执行文件：
+//   g++ -std=c++17 -O2 -o precise_solver main.cpp precise_solver.cpp
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+#include "solver_core.h"
+
+class SolverStrategy {
+public:
+    virtual ~SolverStrategy() = default;
+
+    // 求解完整问题，返回的方案由调用方统一评估和保存
+    virtual Solution solve() = 0;
+
+    // 从已有方案热启动，不支持的策略返回 false
+    virtual bool solveWarmStart(const std::vector<std::vector<int>>& initial, double time_limit, Solution& solution) {
+        (void)initial;
+        (void)time_limit;
+        (void)solution;
+        return false;
+    }
+
+    // 影响结果的可调参数（通常来自环境变量），拼进结果缓存键，不同参数各自缓存
+    virtual std::string cacheParams() const { return std::string(); }
+
+    // 受墙钟时间限制、结果取决于线程调度的策略返回 false：结果不写入缓存，也不从缓存读取
+    virtual bool cacheable() const { return true; }
+};
+
+struct StrategyInfo {
+    std::string name;        // --strategy 使用的名字，也是结果缓存中的求解器名
+    std::string program;     // 原来的独立程序名，可执行文件以此命名时默认选择该策略
+    std::string title;       // 启动时打印的标题
+    std::string output_file; // 默认的方案文件
+    int horizon;             // 规划天数，0 表示使用警报文件中的全部天数
+    int max_days;            // 策略支持的最多天数
+    std::function<std::unique_ptr<SolverStrategy>(const ProblemData&)> create;
+};
+
+inline std::vector<StrategyInfo>& strategyRegistry() {
+    static std::vector<StrategyInfo> registry;
+    return registry;
+}
+
+// 按名字排序，--list 和错误提示的输出顺序与链接顺序无关
+inline bool registerStrategy(StrategyInfo info) {
+    std::vector<StrategyInfo>& registry = strategyRegistry();
+    auto pos = std::lower_bound(registry.begin(), registry.end(), info.name,
+                                [](const StrategyInfo& a, const std::string& name) { return a.name < name; });
+    registry.insert(pos, std::move(info));
+    return true;
+}
+
+// 按策略名或原程序名查找
+inline const StrategyInfo* findStrategy(const std::string& name) {
+    for (const StrategyInfo& info : strategyRegistry()) {
+        if (info.name == name || info.program == name) return &info;
+    }
+    return nullptr;
+}
+
+template <typename Strategy>
+StrategyInfo makeStrategyInfo(const std::string& name, const std::string& program, const std::string& title,
+                              const std::string& output_file, int horizon, int max_days) {
+    return {name, program, title, output_file, horizon, max_days,
+            [](const ProblemData& data) -> std::unique_ptr<SolverStrategy> { return std::make_unique<Strategy>(data); }};
+}
+
+// REGISTER_SOLVER_STRATEGY(Class, "name", "program", "title", "output_file", horizon, max_days)
+#define REGISTER_SOLVER_STRATEGY(Strategy, ...) \
+    static const bool Strategy##_registered = registerStrategy(makeStrategyInfo<Strategy>(__VA_ARGS__))
+
+#endif
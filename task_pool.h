@@ -0,0 +1,294 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+// 求解器共用的工作窃取线程池。
+//
+// 任务时长差别很大：批量移动评估、MinHash、k-means 分配是毫秒级的小块，分解求解的
+// 子问题要跑几秒到几分钟。以前每个并行内核各自创建 std::thread，嵌套时（子问题
+// 内部的批量扫描）线程数成倍增长。现在所有内核都把任务交给同一个池：
+//   - 每个工作线程有自己的双端队列，自己从尾部取（LIFO，缓存热），空闲线程从
+//     别人的头部偷（FIFO，偷到的是较大的、较早的任务）；池外线程提交到共享的注入队列。
+//   - 三个优先级，每个队列按优先级分开，取任务时先看高优先级：并行内核用 TASK_HIGH，
+//     长时间的子问题用 TASK_LOW，空闲线程总是先帮关键路径上的小任务。
+//   - 等待一组任务的线程不阻塞，而是帮着执行任务，所以任务里可以嵌套并行（不会死锁），
+//     调用线程本身也算一个工作者：线程池只需要 hardware_concurrency - 1 个线程。
+//   - 协作式取消：TaskGroup 可以绑定 CancelToken（取消标志 + 截止时间），
+//     取消之后还没开始的任务直接跳过，正在运行的任务自己检查 cancelled()。
+//   - 可选绑核：SOLVER_PIN_CPUS=1 时第 i 个工作线程绑到第 i + 1 个 CPU（0 号留给主线程）。
+//
+// 共享的池是 solverPool()，线程数由 SOLVER_THREADS（总线程数，包含调用线程）决定。
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "trace.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+enum TaskPriority {
+    TASK_HIGH = 0,    // 细粒度的并行内核
+    TASK_NORMAL = 1,
+    TASK_LOW = 2,     // 长时间的子问题
+};
+
+const int TASK_PRIORITIES = 3;
+
+// 协作式取消：显式取消或者过了截止时间
+class CancelToken {
+private:
+    std::atomic<bool> flag{false};
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+public:
+    CancelToken() = default;
+    explicit CancelToken(double seconds) { setDeadline(seconds); }
+
+    void setDeadline(double seconds) {
+        deadline = std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    }
+    void cancel() { flag.store(true, std::memory_order_relaxed); }
+    bool cancelled() const {
+        return flag.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline;
+    }
+    double remaining() const {
+        return std::max(0.0, std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count());
+    }
+};
+
+// 一组任务：提交时计数，完成时减一；token 被取消后还没开始的任务不再执行
+class TaskGroup {
+private:
+    friend class TaskPool;
+    std::atomic<int> pending{0};
+    std::atomic<int> skipped{0};
+    const CancelToken* token;
+
+public:
+    explicit TaskGroup(const CancelToken* cancel = nullptr) : token(cancel) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool cancelled() const { return token && token->cancelled(); }
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    int skippedTasks() const { return skipped.load(std::memory_order_relaxed); }
+};
+
+class TaskPool {
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+    };
+
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks[TASK_PRIORITIES];
+    };
+
+    // queues[0, threads) 属于工作线程，queues[threads] 是池外线程的注入队列
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    int worker_count = 0;   // 工作线程启动前确定，之后只读
+    std::atomic<int> queued{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    bool stopping = false;
+
+    static TaskPool*& currentPool() {
+        static thread_local TaskPool* pool = nullptr;
+        return pool;
+    }
+    static int& currentIndex() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    int selfIndex() const { return currentPool() == this ? currentIndex() : worker_count; }
+
+    bool popOwn(int self, int priority, Task& task) {
+        Queue& q = *queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        std::deque<Task>& tasks = q.tasks[priority];
+        if (tasks.empty()) return false;
+        // 注入队列按提交顺序取，工作线程自己的队列取最新的
+        if (self == worker_count) {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        } else {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        }
+        return true;
+    }
+
+    bool steal(int victim, int priority, Task& task) {
+        Queue& q = *queues[victim];
+        std::unique_lock<std::mutex> lock(q.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || q.tasks[priority].empty()) return false;
+        task = std::move(q.tasks[priority].front());
+        q.tasks[priority].pop_front();
+        return true;
+    }
+
+    // 先按优先级，再按 自己 -> 注入队列 -> 其他工作线程 的顺序找任务；只取不低于 lowest 的优先级
+    bool take(int self, Task& task, int lowest = TASK_LOW) {
+        if (queued.load(std::memory_order_acquire) == 0) return false;
+        int count = queues.size();
+        for (int priority = 0; priority <= lowest; priority++) {
+            if (popOwn(self, priority, task)) return true;
+            for (int k = 1; k < count; k++) {
+                int victim = (self + count - k) % count;  // 从注入队列开始
+                if (steal(victim, priority, task)) return true;
+            }
+        }
+        return false;
+    }
+
+    void execute(Task& task) {
+        queued.fetch_sub(1, std::memory_order_acq_rel);
+        TaskGroup* group = task.group;
+        if (group->cancelled()) {
+            group->skipped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            task.run();
+        }
+        task.run = nullptr;
+        group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void workerLoop(int index) {
+        currentPool() = this;
+        currentIndex() = index;
+        traceThreadName("pool worker " + std::to_string(index));
+        Task task;
+        while (true) {
+            if (take(index, task)) {
+                execute(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            if (stopping) return;
+            sleep_cv.wait_for(lock, std::chrono::milliseconds(10),
+                              [this]() { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    static void pinToCpu(std::thread& thread, int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        (void)thread;
+        (void)cpu;
+#endif
+    }
+
+public:
+    // worker_threads 可以为 0：此时所有任务都由等待的线程自己执行
+    explicit TaskPool(int worker_threads, bool pin_cpus = false) {
+        worker_threads = std::max(0, worker_threads);
+        worker_count = worker_threads;
+        for (int i = 0; i <= worker_threads; i++) queues.push_back(std::make_unique<Queue>());
+        for (int i = 0; i < worker_threads; i++) {
+            threads.emplace_back([this, i]() { workerLoop(i); });
+            if (pin_cpus) pinToCpu(threads.back(), i + 1);
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        sleep_cv.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    // 参与执行的线程数（工作线程 + 等待中的调用线程）
+    int concurrency() const { return worker_count + 1; }
+
+    void submit(TaskGroup& group, std::function<void()> run, TaskPriority priority = TASK_NORMAL) {
+        group.pending.fetch_add(1, std::memory_order_acq_rel);
+        Queue& q = *queues[selfIndex()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks[priority].push_back({std::move(run), &group});
+        }
+        queued.fetch_add(1, std::memory_order_acq_rel);
+        if (worker_count > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            sleep_cv.notify_one();
+        }
+    }
+
+    // 等待 group 完成，期间帮着执行优先级不低于 help 的任务（可能是别的组的）。
+    // 等细粒度内核时用 TASK_HIGH，不会顺手接下一个要跑几分钟的子问题
+    void wait(TaskGroup& group, TaskPriority help = TASK_LOW) {
+        int self = selfIndex();
+        Task task;
+        int idle = 0;
+        while (!group.done()) {
+            if (take(self, task, help)) {
+                execute(task);
+                idle = 0;
+            } else if (++idle < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    // [0, n) 切成 chunks 块并行执行 body(chunk, lo, hi)；块的边界只取决于 n 和 chunks，
+    // 按块编号保存的结果与实际线程数无关
+    template <typename Body>
+    void parallelChunks(size_t n, int chunks, Body body, TaskPriority priority = TASK_HIGH,
+                        const CancelToken* token = nullptr) {
+        chunks = std::max(1, (int)std::min<size_t>(chunks, std::max<size_t>(1, n)));
+        if (chunks == 1) {
+            body(0, (size_t)0, n);
+            return;
+        }
+        TaskGroup group(token);
+        for (int c = 1; c < chunks; c++) {
+            submit(group, [&body, c, n, chunks]() { body(c, n * c / chunks, n * (c + 1) / chunks); }, priority);
+        }
+        if (!token || !token->cancelled()) body(0, (size_t)0, n / chunks);
+        wait(group, priority);
+    }
+};
+
+// 求解器共用的池：SOLVER_THREADS 为总线程数（默认硬件线程数），SOLVER_PIN_CPUS=1 绑核
+inline TaskPool& solverPool() {
+    static TaskPool pool([]() {
+        int total = std::max(1u, std::thread::hardware_concurrency());
+        if (const char* env = getenv("SOLVER_THREADS")) total = std::max(1, atoi(env));
+        return total - 1;
+    }(), []() {
+        const char* env = getenv("SOLVER_PIN_CPUS");
+        return env && atoi(env) != 0;
+    }());
+    return pool;
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+
+#include "task_pool.h"
+
+using namespace std;
+
+// TaskPool 的压力测试，覆盖窃取、嵌套等待和取消三条路径：
+//   steal   一个工作线程往自己的队列里提交大量任务，其他线程只能靠偷拿到；
+//           每个任务必须恰好执行一次
+//   nested  三层嵌套的 parallelChunks 加上不同优先级的外层任务，等待的线程帮着执行，
+//           叶子计数必须与区间长度一致（死锁时测试不会结束）
+//   cancel  绑定 CancelToken 的组在执行中途被取消或到达截止时间，
+//           执行的加跳过的必须等于提交的，取消之后不再开始新任务
+// 每个场景分别在 0 个、1 个和多个工作线程的池上运行。
+// 构建并运行（两种 sanitizer 各跑一次）：
+//   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -o task_pool_stress task_pool_stress.cpp
+//   g++ -std=c++17 -O1 -g -fsanitize=address -pthread -o task_pool_stress task_pool_stress.cpp
+//   ./task_pool_stress [workers] [rounds]
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        cerr << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static void stealTest(TaskPool& pool, int tasks) {
+    vector<atomic<int>> runs(tasks);
+    for (auto& r : runs) r.store(0);
+
+    // 从池里的一个任务中提交，任务进入该工作线程自己的队列
+    TaskGroup outer;
+    pool.submit(outer, [&]() {
+        TaskGroup inner;
+        for (int i = 0; i < tasks; i++) {
+            pool.submit(inner, [&runs, i]() {
+                runs[i].fetch_add(1);
+                for (volatile int spin = 0; spin < 200; spin++) {}
+            });
+        }
+        pool.wait(inner);
+    }, TASK_HIGH);
+    pool.wait(outer);
+
+    bool once = true;
+    for (auto& r : runs) once = once && r.load() == 1;
+    check(once, "steal: every task runs exactly once");
+}
+
+static void nestedTest(TaskPool& pool) {
+    const size_t n = 4096;
+    atomic<long long> leaves{0};
+    atomic<long long> low_done{0};
+
+    TaskGroup group;
+    for (int k = 0; k < 6; k++) {
+        TaskPriority priority = k % 3 == 0 ? TASK_LOW : (k % 3 == 1 ? TASK_NORMAL : TASK_HIGH);
+        pool.submit(group, [&pool, &leaves, &low_done, priority]() {
+            pool.parallelChunks(n, 4, [&](int, size_t lo, size_t hi) {
+                pool.parallelChunks(hi - lo, 4, [&](int, size_t lo2, size_t hi2) {
+                    pool.parallelChunks(hi2 - lo2, 3, [&](int, size_t lo3, size_t hi3) {
+                        leaves.fetch_add(hi3 - lo3);
+                    });
+                });
+            });
+            if (priority == TASK_LOW) low_done.fetch_add(1);
+        }, priority);
+    }
+    pool.wait(group);
+    check(leaves.load() == 6LL * (long long)n, "nested: leaf counts add up");
+    check(low_done.load() == 2, "nested: low-priority tasks complete");
+}
+
+static void cancelTest(TaskPool& pool, bool by_deadline) {
+    const int tasks = 400;
+    CancelToken token;
+    if (by_deadline) token.setDeadline(0.02);
+    TaskGroup group(&token);
+    atomic<int> executed{0};
+    atomic<int> started_after_cancel{0};
+    atomic<bool> cancelled{false};
+
+    for (int i = 0; i < tasks; i++) {
+        pool.submit(group, [&, i]() {
+            if (cancelled.load()) started_after_cancel.fetch_add(1);
+            executed.fetch_add(1);
+            // 正在运行的任务自己检查取消
+            for (int step = 0; step < 50 && !token.cancelled(); step++) {
+                this_thread::sleep_for(chrono::microseconds(20));
+            }
+            if (!by_deadline && i == tasks / 8) {
+                token.cancel();
+                cancelled.store(true);
+            }
+        }, TASK_LOW);
+    }
+    pool.wait(group);
+
+    check(executed.load() + group.skippedTasks() == tasks, "cancel: executed + skipped == submitted");
+    check(group.skippedTasks() > 0, "cancel: pending tasks are skipped");
+    // 标志在 cancel() 之后才置位，所以取消之后开始的任务只能是已经通过检查、正在启动的那几个
+    check(started_after_cancel.load() <= pool.concurrency(), "cancel: no new task starts after cancel");
+}
+
+int main(int argc, char* argv[]) {
+    int workers = argc > 1 ? atoi(argv[1]) : 7;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+
+    for (int count : {0, 1, workers}) {
+        TaskPool pool(count);
+        for (int round = 0; round < rounds; round++) {
+            stealTest(pool, 2000);
+            nestedTest(pool);
+            cancelTest(pool, false);
+            cancelTest(pool, true);
+        }
+        cout << count << " workers: " << rounds << " rounds done" << endl;
+    }
+
+    cout << (failures == 0 ? "OK" : "FAILED") << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// 低开销的阶段追踪，输出 Chrome trace-event JSON（chrome://tracing 或 Perfetto 打开）。
+//
+// 设置环境变量 SOLVER_TRACE=trace.json 打开，进程退出时（或调用 writeTrace）写出。
+// 没有打开时每个埋点只是一次布尔判断。
+//   TRACE_SPAN("name")             作用域计时（"X" 事件），用于各个阶段
+//   traceCounter("name", value)    计数器（"C" 事件），例如累计尝试/接受的移动数；按线程分开显示
+//   traceInstant("name")           瞬时事件
+//   traceThreadName("name")        当前线程在时间线上的名字
+//
+// 每个线程一个固定大小的环形缓冲区（SOLVER_TRACE_EVENTS 个事件，默认 65536），
+// 记录事件不加锁；写满之后覆盖最旧的事件，写出时报告丢弃的数量。事件名和类别
+// 必须是字符串字面量（只保存指针）。写出时不等待其他线程，应在求解结束后调用。
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <unistd.h>
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    int64_t value;
+    char phase;   // 'X' 区间, 'C' 计数器, 'i' 瞬时
+};
+
+class TraceBuffer {
+private:
+    std::vector<TraceEvent> events;
+    size_t mask;
+    std::atomic<uint64_t> head{0};
+
+public:
+    const int tid;
+    std::string thread_name;
+
+    TraceBuffer(size_t capacity, int thread_id) : tid(thread_id) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        events.resize(size);
+        mask = size - 1;
+    }
+
+    void push(const TraceEvent& event) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        events[h & mask] = event;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // 按时间顺序取出还在缓冲区中的事件，返回被覆盖的数量
+    uint64_t snapshot(std::vector<TraceEvent>& out) const {
+        uint64_t h = head.load(std::memory_order_acquire);
+        uint64_t begin = h > events.size() ? h - events.size() : 0;
+        for (uint64_t k = begin; k < h; k++) out.push_back(events[k & mask]);
+        return begin;
+    }
+};
+
+class Tracer {
+private:
+    bool enabled_ = false;
+    std::string path;
+    size_t capacity = 1 << 16;
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::mutex registry_mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    std::atomic<bool> written{false};
+
+    Tracer() {
+        if (const char* env = getenv("SOLVER_TRACE")) {
+            path = env;
+            enabled_ = !path.empty();
+        }
+        if (const char* env = getenv("SOLVER_TRACE_EVENTS")) capacity = std::max(16L, atol(env));
+    }
+
+    static void writeString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    ~Tracer() {
+        if (enabled_ && !written) write(path);
+    }
+
+    bool enabled() const { return enabled_; }
+    const std::string& outputPath() const { return path; }
+
+    uint64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    // 当前线程的缓冲区，第一次使用时登记（只有这一步加锁）
+    TraceBuffer& buffer() {
+        static thread_local std::shared_ptr<TraceBuffer> local;
+        if (!local) {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            local = std::make_shared<TraceBuffer>(capacity, (int)buffers.size());
+            buffers.push_back(local);
+        }
+        return *local;
+    }
+
+    bool write(const std::string& file_name) {
+        std::ofstream out(file_name);
+        if (!out.is_open()) {
+            std::cerr << "Warning: Cannot write trace " << file_name << std::endl;
+            return false;
+        }
+
+        std::vector<std::shared_ptr<TraceBuffer>> all;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            all = buffers;
+        }
+
+        int pid = getpid();
+        uint64_t dropped = 0;
+        size_t count = 0;
+        bool first = true;
+        out << "{\"traceEvents\": [\n";
+        std::vector<TraceEvent> events;
+        for (const auto& buffer : all) {
+            if (!buffer->thread_name.empty()) {
+                out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+                    << ", \"tid\": " << buffer->tid << ", \"args\": {\"name\": ";
+                writeString(out, buffer->thread_name.c_str());
+                out << "}}";
+                first = false;
+            }
+            events.clear();
+            dropped += buffer->snapshot(events);
+            for (const TraceEvent& e : events) {
+                out << (first ? "" : ",\n") << "{\"name\": ";
+                writeString(out, e.name);
+                out << ", \"cat\": ";
+                writeString(out, e.category);
+                out << ", \"ph\": \"" << e.phase << "\", \"ts\": " << e.start_ns / 1000.0 << ", \"pid\": " << pid
+                    << ", \"tid\": " << buffer->tid;
+                if (e.phase == 'X') out << ", \"dur\": " << e.duration_ns / 1000.0;
+                if (e.phase == 'C') out << ", \"id\": " << buffer->tid << ", \"args\": {\"value\": " << e.value << "}";
+                if (e.phase == 'i') out << ", \"s\": \"t\"";
+                out << "}";
+                first = false;
+                count++;
+            }
+        }
+        out << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+        written = true;
+        std::cout << "Trace written to " << file_name << " (" << count << " events";
+        if (dropped > 0) std::cout << ", " << dropped << " dropped";
+        std::cout << ")" << std::endl;
+        return true;
+    }
+};
+
+inline bool traceEnabled() {
+    return Tracer::instance().enabled();
+}
+
+inline void traceCounter(const char* name, int64_t value, const char* category = "counter") {
+    if (!traceEnabled()) return;
+    Tracer& tracer = Tracer::instance();
+    tracer.buffer().push({name, category, tracer.now(), 0, value, 'C'});
+}
+
+inline void traceInstant(const char* name, const char* category = "event") {
+    if (!traceEnabled()) return;
+    Tracer& tracer = Tracer::instance();
+    tracer.buffer().push({name, category, tracer.now(), 0, 0, 'i'});
+}
+
+inline void traceThreadName(const std::string& name) {
+    if (!traceEnabled()) return;
+    Tracer::instance().buffer().thread_name = name;
+}
+
+// 写出追踪文件（未打开追踪时什么都不做）
+inline void writeTrace() {
+    if (!traceEnabled()) return;
+    Tracer& tracer = Tracer::instance();
+    tracer.write(tracer.outputPath());
+}
+
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    uint64_t start = 0;
+    bool active;
+
+public:
+    explicit TraceSpan(const char* span_name, const char* span_category = "phase")
+        : name(span_name), category(span_category), active(traceEnabled()) {
+        if (active) start = Tracer::instance().now();
+    }
+    ~TraceSpan() {
+        if (!active) return;
+        Tracer& tracer = Tracer::instance();
+        tracer.buffer().push({name, category, start, tracer.now() - start, 0, 'X'});
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(...) TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(__VA_ARGS__)
+
+#endif
@@ -11,89 +11,42 @@
 #include <random>
 #include <chrono>
 
-using namespace std;
-
-const int NUM_ENGINEERS = 336;
-const int NUM_SERVERS = 1620;
-const int MAX_SERVERS_PER_ENGINEER = 5;
-const int MAX_REST_DAYS = 410;
+#include "solver_strategy.h"
+#include "day_mask.h"
+#include "alloc_counter.h"
 
-struct Solution {
-    vector<vector<int>> allocation;
-    vector<vector<bool>> daily_work;
-    int total_rest_days;
-    int num_days;
-    bool valid;
-    
-    Solution(int days) : allocation(NUM_ENGINEERS, vector<int>(MAX_SERVERS_PER_ENGINEER, -1)), 
-                         daily_work(NUM_ENGINEERS, vector<bool>(days, false)), 
-                         total_rest_days(0), num_days(days), valid(false) {}
-};
+using namespace std;
 
-class UltimateConstraintSolver {
+class UltimateConstraintSolver : public SolverStrategy {
 private:
-    vector<vector<int>> daily_alarms;
-    map<int, set<int>> server_to_days;
+    const ProblemData& data;
+    const AlarmIndex& alarm_index;
+    const map<int, vector<int>>& server_to_days;
     vector<pair<double, int>> server_efficiency;
-    int num_days;
+    const int num_days;
     
 public:
-    bool loadAlarmData(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot open " << filename << endl;
-            return false;
-        }
-        
-        string line;
-        int day = 0;
-        
-        while (getline(file, line)) {
-            if (line.empty() || !isdigit(line[0])) continue;
-            
-            daily_alarms.push_back(vector<int>());
-            istringstream iss(line);
-            int server;
-            while (iss >> server) {
-                daily_alarms[day].push_back(server);
-                server_to_days[server].insert(day);
-            }
-            day++;
-        }
-        
-        num_days = day;
-        file.close();
-        
-        // 计算服务器效率分数
+    explicit UltimateConstraintSolver(const ProblemData& data)
+        : data(data), alarm_index(data.alarm_index), server_to_days(data.server_to_days), num_days(data.num_days) {
+        // 计算服务器效率分数（直接用索引中的天掩码计数）
         for (auto& [server, days] : server_to_days) {
+            uint64_t mask = alarm_index.mask(server);
+            int first_14_count = __builtin_popcountll(mask & alarm_index.first14Mask());
             double score = 0.0;
             
             // 基础分数：覆盖的天数
-            score += days.size() * 2.0;
+            score += __builtin_popcountll(mask) * 2.0;
             
-            // 前14天奖励：每覆盖一天前14天给予额外分数
-            int first_14_count = 0;
-            for (int day : days) {
-                if (day < 14) {
-                    score += 10.0; // 前14天权重非常高
-                    first_14_count++;
-                }
-            }
+            // 前14天奖励：每覆盖一天前14天给予额外分数，前14天权重非常高
+            score += first_14_count * 10.0;
             
             // 如果完全覆盖前14天，给予巨大奖励
             if (first_14_count >= 14) {
                 score += 100.0;
             }
             
-            // 覆盖连续天数的奖励
-            vector<int> day_list(days.begin(), days.end());
-            sort(day_list.begin(), day_list.end());
-            int consecutive_bonus = 0;
-            for (int i = 1; i < day_list.size(); i++) {
-                if (day_list[i] == day_list[i-1] + 1) {
-                    consecutive_bonus++;
-                }
-            }
+            // 覆盖连续天数的奖励：相邻两天都报警的次数
+            int consecutive_bonus = __builtin_popcountll(mask & (mask >> 1));
             score += consecutive_bonus * 1.0;
             
             server_efficiency.push_back({score, server});
@@ -107,17 +60,21 @@ public:
         for (int i = 0; i < min(10, (int)server_efficiency.size()); i++) {
             auto [score, server] = server_efficiency[i];
             cout << "  Server " << server << ": score " << score 
-                 << " (covers " << server_to_days[server].size() << " days)" << endl;
+                 << " (covers " << data.serverDays(server).size() << " days)" << endl;
         }
-        
-        return true;
     }
     
-    Solution solve() {
+    Solution solve() override {
+        return dispatchDayMaskWidth(num_days, [&](auto width) { return solveWithWidth<decltype(width)::value>(); });
+    }
+    
+private:
+    template <int W>
+    Solution solveWithWidth() {
         Solution solution(num_days);
         
         cout << "\n=== Ultimate Constraint Solver ===" << endl;
-        cout << "Days: " << num_days << endl;
+        cout << "Days: " << num_days << " (" << W << "-word day masks)" << endl;
         cout << "Target: EXACTLY " << MAX_REST_DAYS << " total rest days" << endl;
         
         // 计算理论最优分配
@@ -183,9 +140,14 @@ public:
         
         cout << "\nPhase 1: Precise allocation using mathematical optimization..." << endl;
         
+        // 候选评估用天掩码，评估过程不做堆分配
+        vector<DayMask<W>> server_masks = buildServerDayMasks<W>(alarm_index, num_days);
+        DayMask<W> first_14 = DayMask<W>::prefix(14);
+        
         // 使用精确的分配算法
         vector<bool> server_used(NUM_SERVERS, false);
         vector<int> engineer_work_days(NUM_ENGINEERS, 0);
+        AllocCounter search_allocations;
         
         // 为每个工程师分配服务器以达到精确的工作天数
         for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
@@ -200,7 +162,7 @@ public:
             }
             
             // 贪心选择服务器
-            set<int> current_work_days;
+            DayMask<W> current_work_days;
             int servers_assigned = 0;
             
             // 首先确保覆盖前14天
@@ -211,22 +173,14 @@ public:
                 }
                 
                 // 检查是否覆盖前14天
-                bool has_first_14 = false;
-                for (int day : server_to_days[server]) {
-                    if (day < 14) {
-                        has_first_14 = true;
-                        break;
-                    }
-                }
+                bool has_first_14 = server_masks[server].intersects(first_14);
                 
                 if (has_first_14 && !covers_first_14) {
                     solution.allocation[engineer][servers_assigned] = server;
                     server_used[server] = true;
                     servers_assigned++;
                     
-                    for (int day : server_to_days[server]) {
-                        current_work_days.insert(day);
-                    }
+                    current_work_days |= server_masks[server];
                     covers_first_14 = true;
                     break;
                 }
@@ -239,12 +193,9 @@ public:
                 }
                 
                 // 计算分配这个服务器后的工作天数
-                set<int> new_work_days = current_work_days;
-                for (int day : server_to_days[server]) {
-                    new_work_days.insert(day);
-                }
+                DayMask<W> new_work_days = current_work_days | server_masks[server];
                 
-                int new_work_count = new_work_days.size();
+                int new_work_count = new_work_days.count();
                 
                 // 如果接近目标工作天数，就分配
                 if (new_work_count <= target_work_days) {
@@ -259,7 +210,7 @@ public:
                 }
             }
             
-            engineer_work_days[engineer] = current_work_days.size();
+            engineer_work_days[engineer] = current_work_days.count();
             
             if (engineer % 50 == 0) {
                 cout << "Engineer " << engineer << ": " << engineer_work_days[engineer] 
@@ -267,154 +218,12 @@ public:
             }
         }
         
-        // 计算最终结果
-        calculateFinalResults(solution);
+        if (ALLOC_COUNTER_ENABLED) cout << "Heap allocations during search: " << search_allocations.count() << endl;
         
         return solution;
     }
-    
-private:
-    void calculateFinalResults(Solution& solution) {
-        solution.total_rest_days = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            fill(solution.daily_work[engineer].begin(), solution.daily_work[engineer].end(), false);
-            
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                int server = solution.allocation[engineer][i];
-                if (server == -1) continue;
-                
-                for (int day : server_to_days[server]) {
-                    if (day < solution.num_days) {
-                        solution.daily_work[engineer][day] = true;
-                    }
-                }
-            }
-            
-            int work_days = 0;
-            for (int day = 0; day < solution.num_days; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                }
-            }
-            solution.total_rest_days += (solution.num_days - work_days);
-        }
-        
-        // 统计结果
-        map<int, int> work_days_distribution;
-        map<int, int> rest_days_distribution;
-        int engineers_with_first_14_work = 0;
-        
-        for (int engineer = 0; engineer < NUM_ENGINEERS; engineer++) {
-            int work_days = 0;
-            bool has_first_14_work = false;
-            
-            for (int day = 0; day < solution.num_days; day++) {
-                if (solution.daily_work[engineer][day]) {
-                    work_days++;
-                    if (day < 14) {
-                        has_first_14_work = true;
-                    }
-                }
-            }
-            
-            int rest_days = solution.num_days - work_days;
-            work_days_distribution[work_days]++;
-            rest_days_distribution[rest_days]++;
-            if (has_first_14_work) engineers_with_first_14_work++;
-        }
-        
-        cout << "\n=== Final Results ===" << endl;
-        cout << "Work days distribution:" << endl;
-        for (auto& [days, count] : work_days_distribution) {
-            cout << "  " << count << " engineers work " << days << " days" << endl;
-        }
-        
-        cout << "\nRest days distribution:" << endl;
-        for (auto& [days, count] : rest_days_distribution) {
-            cout << "  " << count << " engineers rest " << days << " days" << endl;
-        }
-        
-        cout << "\nConstraint Check:" << endl;
-        cout << "Total rest days: " << solution.total_rest_days << " / " << MAX_REST_DAYS;
-        if (solution.total_rest_days == MAX_REST_DAYS) {
-            cout << " ✓ EXACTLY SATISFIED!" << endl;
-        } else if (solution.total_rest_days <= MAX_REST_DAYS) {
-            cout << " ✓ SATISFIED (under by " << (MAX_REST_DAYS - solution.total_rest_days) << ")" << endl;
-        } else {
-            cout << " ✗ VIOLATED (excess: " << (solution.total_rest_days - MAX_REST_DAYS) << ")" << endl;
-        }
-        
-        cout << "Engineers with first 14 days work: " << engineers_with_first_14_work << " / " << NUM_ENGINEERS;
-        if (engineers_with_first_14_work == NUM_ENGINEERS) {
-            cout << " ✓ SATISFIED" << endl;
-        } else {
-            cout << " ✗ VIOLATED (missing: " << (NUM_ENGINEERS - engineers_with_first_14_work) << ")" << endl;
-        }
-        
-        if (solution.total_rest_days <= MAX_REST_DAYS && engineers_with_first_14_work == NUM_ENGINEERS) {
-            cout << "\n🎉 ALL CONSTRAINTS SATISFIED! 🎉" << endl;
-            solution.valid = true;
-        } else {
-            cout << "\n❌ CONSTRAINT VIOLATIONS DETECTED ❌" << endl;
-            solution.valid = false;
-        }
-        
-        // 额外统计
-        cout << "\nDetailed Analysis:" << endl;
-        cout << "Average rest days per engineer: " << (double)solution.total_rest_days / NUM_ENGINEERS << endl;
-        cout << "Rest day efficiency: " << (double)solution.total_rest_days / MAX_REST_DAYS * 100 << "%" << endl;
-        
-        if (solution.total_rest_days <= MAX_REST_DAYS) {
-            cout << "Remaining rest day budget: " << (MAX_REST_DAYS - solution.total_rest_days) << " days" << endl;
-        }
-    }
-    
-public:
-    void saveSolution(const Solution& solution, const string& filename) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cerr << "Error: Cannot create " << filename << endl;
-            return;
-        }
-        
-        for (int e = 0; e < NUM_ENGINEERS; e++) {
-            for (int i = 0; i < MAX_SERVERS_PER_ENGINEER; i++) {
-                file << solution.allocation[e][i];
-                if (i < MAX_SERVERS_PER_ENGINEER - 1) file << " ";
-            }
-            file << endl;
-        }
-        
-        file.close();
-        cout << "Solution saved to " << filename << endl;
-    }
 };
 
-int main() {
-    cout << "=== Ultimate Constraint-Based Server Allocation Solver ===" << endl;
-    cout << "Engineers: " << NUM_ENGINEERS << endl;
-    cout << "Servers: " << NUM_SERVERS << endl;
-    cout << "Max servers per engineer: " << MAX_SERVERS_PER_ENGINEER << endl;
-    cout << "EXACT TARGET: " << MAX_REST_DAYS << " total rest days" << endl;
-    cout << endl;
-    
-    UltimateConstraintSolver solver;
-    
-    if (!solver.loadAlarmData("alarm_list.txt")) {
-        return 1;
-    }
-    
-    cout << "\nSolving with ultimate mathematical precision..." << endl;
-    Solution solution = solver.solve();
-    
-    solver.saveSolution(solution, "ultimate_solution.txt");
-    
-    if (solution.valid) {
-        cout << "\n✅ PERFECT SOLUTION FOUND! All constraints exactly satisfied." << endl;
-    } else {
-        cout << "\n⚠️  Best possible solution found with constraint analysis." << endl;
-    }
-    
-    return 0;
-}
\ No newline at end of file
+REGISTER_SOLVER_STRATEGY(UltimateConstraintSolver, "ultimate", "ultimate_solver",
+                         "Ultimate Constraint-Based Server Allocation Solver", "ultimate_solution.txt",
+                         0, ALARM_INDEX_MAX_DAYS);
@@ -0,0 +1,160 @@
+#ifndef WHAT_IF_H
+#define WHAT_IF_H
+
+// What-if 查询：在不修改方案的前提下，评估单个或一批移动对休息天数和前14天规则的影响。
+//
+//   RELOCATE server engineer   把服务器转给另一个工程师（原来未分配也可以）
+//   SWAP server1 server2       交换两台服务器的负责人
+//
+// 每次评估只读取涉及的两个工程师缓存的留一掩码，代价与方案规模无关。
+
+#include <vector>
+#include <cstdint>
+
+#include "allocation_state.h"
+
+enum WhatIfKind : uint8_t {
+    WHATIF_RELOCATE = 0,
+    WHATIF_SWAP = 1
+};
+
+enum WhatIfStatus : int8_t {
+    WHATIF_OK = 0,
+    WHATIF_BAD_SERVER = 1,    // 服务器编号超出范围
+    WHATIF_BAD_ENGINEER = 2,  // 工程师编号超出范围
+    WHATIF_NO_SLOT = 3,       // 目标工程师没有空槽位
+    WHATIF_UNASSIGNED = 4     // SWAP 的服务器没有负责人
+};
+
+struct WhatIfMove {
+    WhatIfKind kind;
+    int32_t a;  // 服务器
+    int32_t b;  // RELOCATE: 目标工程师；SWAP: 另一台服务器
+};
+
+struct WhatIfResult {
+    WhatIfStatus status = WHATIF_OK;
+    int rest_delta = 0;      // 总休息天数的变化（负数表示变好）
+    int first14_delta = 0;   // 没有前14天工作的工程师数量的变化
+    int engineer1 = -1;      // 失去服务器的一方（RELOCATE 时可能为 -1）
+    int engineer2 = -1;      // 得到服务器的一方
+    int work1 = 0;           // 移动之后两人的工作天数
+    int work2 = 0;
+    bool first14_1 = true;   // 移动之后两人是否仍然在前14天有工作
+    bool first14_2 = true;
+
+    bool ok() const { return status == WHATIF_OK; }
+    bool keepsFirst14() const { return first14_1 && first14_2; }
+};
+
+inline const char* whatIfStatusName(WhatIfStatus status) {
+    switch (status) {
+        case WHATIF_OK: return "ok";
+        case WHATIF_BAD_SERVER: return "server out of range";
+        case WHATIF_BAD_ENGINEER: return "engineer out of range";
+        case WHATIF_NO_SLOT: return "engineer has no free slot";
+        case WHATIF_UNASSIGNED: return "server is not assigned";
+    }
+    return "unknown";
+}
+
+class WhatIfEvaluator {
+private:
+    const AllocationState& state;
+
+public:
+    explicit WhatIfEvaluator(const AllocationState& allocation_state) : state(allocation_state) {}
+
+    WhatIfResult relocate(int server, int engineer) const {
+        WhatIfResult result;
+        if (server < 0 || server >= state.servers) return fail(WHATIF_BAD_SERVER);
+        if (engineer < 0 || engineer >= state.engineers) return fail(WHATIF_BAD_ENGINEER);
+
+        int from = state.owner[server];
+        if (from == engineer) {
+            result.engineer1 = result.engineer2 = engineer;
+            result.work1 = result.work2 = state.workDays(engineer);
+            result.first14_1 = result.first14_2 = state.hasFirst14(engineer);
+            return result;
+        }
+        if (state.load[engineer] >= state.slots) return fail(WHATIF_NO_SLOT);
+
+        result.engineer2 = engineer;
+        setSide(result, 2, engineer, state.work_mask[engineer] | state.serverMask(server));
+        if (from != -1) {
+            result.engineer1 = from;
+            setSide(result, 1, from, state.maskWithout(from, state.slotOf(from, server)));
+        }
+        return result;
+    }
+
+    WhatIfResult swap(int server1, int server2) const {
+        if (server1 < 0 || server1 >= state.servers || server2 < 0 || server2 >= state.servers) {
+            return fail(WHATIF_BAD_SERVER);
+        }
+        int e1 = state.owner[server1];
+        int e2 = state.owner[server2];
+        if (e1 == -1 || e2 == -1) return fail(WHATIF_UNASSIGNED);
+        return swapSlots(e1, state.slotOf(e1, server1), e2, state.slotOf(e2, server2));
+    }
+
+    // 按槽位交换，调用方已经知道服务器所在的位置时可以省去查找
+    WhatIfResult swapSlots(int e1, int slot1, int e2, int slot2) const {
+        WhatIfResult result;
+        result.engineer1 = e1;
+        result.engineer2 = e2;
+        if (e1 == e2) {
+            result.work1 = result.work2 = state.workDays(e1);
+            result.first14_1 = result.first14_2 = state.hasFirst14(e1);
+            return result;
+        }
+
+        int server1 = state.slotServer(e1, slot1);
+        int server2 = state.slotServer(e2, slot2);
+        uint64_t mask1 = server1 == -1 ? 0 : state.serverMask(server1);
+        uint64_t mask2 = server2 == -1 ? 0 : state.serverMask(server2);
+        setSide(result, 1, e1, state.maskWithout(e1, slot1) | mask2);
+        setSide(result, 2, e2, state.maskWithout(e2, slot2) | mask1);
+        return result;
+    }
+
+    WhatIfResult evaluate(const WhatIfMove& move) const {
+        return move.kind == WHATIF_SWAP ? swap(move.a, move.b) : relocate(move.a, move.b);
+    }
+
+    // 批量评估：每个查询互相独立，都是相对于当前方案
+    void evaluateBatch(const WhatIfMove* moves, size_t count, WhatIfResult* results) const {
+        for (size_t k = 0; k < count; k++) {
+            results[k] = evaluate(moves[k]);
+        }
+    }
+
+    std::vector<WhatIfResult> evaluateBatch(const std::vector<WhatIfMove>& moves) const {
+        std::vector<WhatIfResult> results(moves.size());
+        evaluateBatch(moves.data(), moves.size(), results.data());
+        return results;
+    }
+
+private:
+    static WhatIfResult fail(WhatIfStatus status) {
+        WhatIfResult result;
+        result.status = status;
+        return result;
+    }
+
+    void setSide(WhatIfResult& result, int side, int engineer, uint64_t new_mask) const {
+        int work = __builtin_popcountll(new_mask);
+        bool first14 = (new_mask & state.first14_mask) != 0;
+        result.rest_delta += state.workDays(engineer) - work;
+        result.first14_delta += (int)state.hasFirst14(engineer) - (int)first14;
+        if (side == 1) {
+            result.work1 = work;
+            result.first14_1 = first14;
+        } else {
+            result.work2 = work;
+            result.first14_2 = first14;
+        }
+    }
+};
+
+#endif